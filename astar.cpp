@@ -0,0 +1,133 @@
+/***************************************************************************//**
+ * @file astar.cpp
+ *
+ * @brief functions for the AStarSP implementation
+ *
+ * @par Class
+ *    CSC315 Data Structures
+ ******************************************************************************/
+
+#include "astar.h"
+#include <cstdlib>
+
+
+/*************************************************************************//**
+ * @brief Default constructor for class AStarSP
+ *
+ * @returns an instance of class AStarSP
+ ****************************************************************************/
+AStarSP::AStarSP() : S(0), T(0), width(1), minWeight(0), expandedCount(0) {}
+
+
+/*************************************************************************//**
+ * @brief Constructor for class AStarSP
+ *
+ * @param[in] G - a weighted grid graph
+ * @param[in] s - the starting vertex
+ * @param[in] t - the target vertex
+ *
+ * @returns an instance of class AStarSP
+ ****************************************************************************/
+AStarSP::AStarSP(const WeightedGraph *G, int s, int t) : S(s), T(t),
+  width(1), minWeight(0), expandedCount(0)
+{
+  search(G, s, t);
+}
+
+
+/*************************************************************************//**
+ * @brief runs an A* search from s to t
+ *
+ * @par Description
+ *   Vertices are taken from the queue in order of distance so far plus the
+ *   heuristic estimate of the remaining distance. The search stops as soon
+ *   as the target is removed from the queue. Since the heuristic is
+ *   consistent a vertex never has to be expanded twice. The search itself
+ *   is gridAStar from graphSearch.h, run over the graph's arrays.
+ *
+ * @param[in] G - a weighted grid graph
+ * @param[in] s - the starting vertex
+ * @param[in] t - the target vertex
+ *
+ * @returns none
+ ****************************************************************************/
+void AStarSP::search(const WeightedGraph *G, int s, int t)
+{
+  searchGrid(*G, s, t, G->Width(), G->MinWeight());
+}
+
+
+/*************************************************************************//**
+ * @brief estimates the distance from a vertex to the target
+ *
+ * @param[in] v - the vertex
+ *
+ * @returns the Manhattan distance to the target times the cheapest weight
+ ****************************************************************************/
+int AStarSP::heuristic(int v) const
+{
+  int dx = abs(v % width - T % width);
+  int dy = abs(v / width - T / width);
+
+  return minWeight * (dx + dy);
+}
+
+
+/*************************************************************************//**
+ * @brief checks if a path to the vertex was found
+ *
+ * @param[in] v - the vertex
+ *
+ * @returns true - if there is a path
+ * 	    false - if there is no path
+ ****************************************************************************/
+bool AStarSP::hasPathTo(int v) const
+{
+  if (v < 0 || v >= (int)dist.size())
+    return false;
+
+  return dist[v] != INFINITE_DISTANCE;
+}
+
+
+/*************************************************************************//**
+ * @brief the path between the start and a vertex
+ *
+ * @param[in] v - the destination vertex
+ *
+ * @returns path - the path from the starting node to the destination
+ ****************************************************************************/
+stack<int> AStarSP::pathTo(int v) const
+{
+  stack<int> path;
+
+  if (!hasPathTo(v)) return path;
+  for (int x = v ; x != S ; x = prev[x])
+    path.push(x);
+
+  return path;
+}
+
+
+/*************************************************************************//**
+ * @brief gets the distance of the vertex from the starting vertex
+ *
+ * @param[in] v - the destination vertex
+ *
+ * @returns dist - the distance between the nodes
+ ****************************************************************************/
+int AStarSP::distance(int v) const
+{
+  if (v < 0 || v >= (int)dist.size())
+    return INFINITE_DISTANCE;
+
+  return dist[v];
+}
+
+
+/*************************************************************************//**
+ * @brief gets the number of vertices taken from the queue by the last search
+ *
+ * @returns expandedCount - number of expanded vertices
+ ****************************************************************************/
+int AStarSP::expanded() const { return expandedCount; }
@@ -0,0 +1,76 @@
+/***************************************************************************//**
+ * @file astar.h
+ *
+ * @brief header file for the A* shortest path class
+ *
+ * @par Class
+ *    CSC315 Data Structures
+ ******************************************************************************/
+
+#ifndef ASTAR_H
+#define ASTAR_H
+
+#include <stack>
+#include <vector>
+#include "weightedGraph.h"
+#include "indexMinPQ.h"
+#include "dijkstra.h"
+
+/*!
+* @brief contains data for an A* search between two cells of a grid graph.
+*        The heuristic is the Manhattan distance to the target scaled by
+*        the cheapest edge weight, so it never overestimates and the path
+*        found is as short as the one dijkstra's algorithm finds.
+*/
+class AStarSP
+{
+   vector<int> prev;
+   vector<int> dist;
+   IndexMinPQ pq;
+   int S;
+   int T;
+   int width;
+   int minWeight;
+   int expandedCount;
+public:
+   AStarSP();
+   AStarSP(const WeightedGraph *, int, int);
+
+   void search(const WeightedGraph *, int, int);
+   template <class G> void searchGrid(const G &, int, int, int, int);
+   int heuristic(int) const;
+   int distance(int) const;
+   bool hasPathTo(int) const;
+   stack<int> pathTo(int) const;
+   int expanded() const;
+};
+
+
+/*************************************************************************//**
+ * @brief runs an A* search from s to t over any grid graph
+ *
+ * @par Description
+ *   Runs gridAStar from graphSearch.h on a type that models the grid graph
+ *   concept, such as an ImplicitGrid over the playfield, so no graph has
+ *   to be built first.
+ *
+ * @param[in] g - a grid graph
+ * @param[in] s - the starting vertex
+ * @param[in] t - the target vertex
+ * @param[in] w - the width of the grid, for the heuristic
+ * @param[in] minW - the cheapest cost of a step, for the heuristic
+ *
+ * @returns none
+ ****************************************************************************/
+template <class G>
+void AStarSP::searchGrid(const G &g, int s, int t, int w, int minW)
+{
+  S = s;
+  T = t;
+  width = w;
+  minWeight = minW;
+  expandedCount = gridAStar(g, s, t, [this](int v) { return heuristic(v); },
+                            dist, prev, pq);
+}
+
+#endif
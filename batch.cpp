@@ -0,0 +1,307 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <unistd.h>
+#include <vector>
+#include "game.h"
+#include "player.h"
+#include "pluginPlayer.h"
+#include "threadPool.h"
+
+using namespace std;
+using namespace std::chrono;
+
+// Everything one game reports back to the batch
+struct GameResult
+{
+   int score;
+   vector<double> turnTimes;   // microseconds
+   string replay;              // replay record, if asked for
+   long dropped;               // telemetry records the log dropped
+};
+
+// A strategy taking part in the batch: the built-in player, or a plugin
+// with its options
+struct Contender
+{
+   string name;
+   SearchMode mode;
+   PluginLibrary *library;
+   string options;
+
+   Strategy *create() const
+   {
+      return library ? library->create(options) : new Player(mode);
+   }
+};
+
+// Play one seeded game to the end.  Each game owns its player, playfield
+// and random generator, so games on different threads share nothing.
+// logSuffix tells the logs of different contenders on one seed apart.
+static void playGame(unsigned seed, const Contender *contender, int width,
+                     int height, bool obstacles, double density,
+                     const string &logPrefix, const string &logSuffix,
+                     bool record, GameResult *result)
+{
+   Game game(contender->create(), width, height, obstacles, seed, density);
+   TelemetryLog *log = NULL;
+   if (!logPrefix.empty())
+   {
+      log = new TelemetryLog(logPrefix + to_string(seed) + logSuffix +
+                             ".tlog", width, height);
+      game.setTelemetry(log);
+   }
+   ReplayRecorder replay(seed, obstacles, density);
+   if (record) game.setReplay(&replay);
+
+   while (!game.isGameOver())
+   {
+      steady_clock::time_point start = steady_clock::now();
+      game.makeMove();
+      steady_clock::time_point end = steady_clock::now();
+      result->turnTimes.push_back(
+         duration<double, std::micro>(end - start).count());
+   }
+   result->score = game.getScore();
+   result->dropped = log ? log->droppedCount() : 0;
+   if (record) replay.append(result->replay);
+   delete log;
+}
+
+// Value at fraction p of a sorted vector
+static double percentile(const vector<double> &sorted, double p)
+{
+   if (sorted.empty()) return 0.0;
+   size_t index = (size_t)(p * (sorted.size() - 1) + 0.5);
+   return sorted[index];
+}
+
+static void usage(const char *name)
+{
+   cerr << "Usage: " << name << " [-g games] [-j threads] [-s seed]"
+        << " [-m dijkstra|astar|dstar|survival|hamilton]"
+        << " [-W width] [-H height] [-o] [-d density] [-l prefix]"
+        << " [-r file] [-p plugin[:options]]..." << endl;
+   cerr << "  -o places obstacles on every playfield" << endl;
+   cerr << "  -d sets the fraction of cells that are obstacles, and implies -o"
+        << endl;
+   cerr << "  -l writes a telemetry log of game seed to <prefix><seed>.tlog"
+        << endl;
+   cerr << "  -r writes the replay of every game to file" << endl;
+   cerr << "  -j 0 uses one thread per hardware thread" << endl;
+   cerr << "  -p plays a strategy loaded from a plugin instead of -m; give"
+        << " several to" << endl
+        << "     compare them on the same seeds" << endl;
+}
+
+// Print the score distribution and turn time percentiles of some games
+static void report(const vector<GameResult *> &results)
+{
+   vector<double> scores;
+   vector<double> turnTimes;
+   long dropped = 0;
+   for (GameResult *r : results)
+   {
+      scores.push_back(r->score);
+      dropped += r->dropped;
+      turnTimes.insert(turnTimes.end(), r->turnTimes.begin(),
+                       r->turnTimes.end());
+   }
+   sort(scores.begin(), scores.end());
+   sort(turnTimes.begin(), turnTimes.end());
+
+   double scoreSum = 0.0;
+   for (double s : scores) scoreSum += s;
+
+   cout << "Score: mean " << scoreSum / scores.size()
+        << "  min " << scores.front()
+        << "  p10 " << percentile(scores, 0.10)
+        << "  p50 " << percentile(scores, 0.50)
+        << "  p90 " << percentile(scores, 0.90)
+        << "  max " << scores.back() << endl;
+   cout << "Turn time (us): p50 " << percentile(turnTimes, 0.50)
+        << "  p90 " << percentile(turnTimes, 0.90)
+        << "  p99 " << percentile(turnTimes, 0.99)
+        << "  max " << (turnTimes.empty() ? 0.0 : turnTimes.back()) << endl;
+   if (dropped > 0)
+      cout << "Telemetry records dropped: " << dropped << endl;
+
+   // Score histogram in buckets of ten
+   cout << "Score histogram:" << endl;
+   int buckets = (int)scores.back() / 10 + 1;
+   vector<int> histogram(buckets, 0);
+   for (double s : scores) histogram[(int)s / 10]++;
+   for (int b = 0 ; b < buckets ; b++)
+      cout << setw(5) << b * 10 << "-" << setw(5) << left << b * 10 + 9
+           << right << setw(8) << histogram[b] << endl;
+}
+
+// Load the plugin of a -p argument, path[:options]
+static bool addPlugin(const string &arg, vector<Contender> &contenders)
+{
+   size_t colon = arg.find(':');
+   Contender c;
+   c.mode = DIJKSTRA;
+   c.library = new PluginLibrary(arg.substr(0, colon));
+   c.options = colon == string::npos ? "" : arg.substr(colon + 1);
+   c.name = c.library->getName();
+   if (!c.options.empty()) c.name += ":" + c.options;
+
+   if (!c.library->good())
+   {
+      cerr << c.library->getError() << endl;
+      delete c.library;
+      return false;
+   }
+   Strategy *probe = c.create();
+   if (probe == NULL)
+   {
+      cerr << arg << ": the plugin does not accept these options" << endl;
+      delete c.library;
+      return false;
+   }
+   delete probe;
+   contenders.push_back(c);
+   return true;
+}
+
+// Play many seeded games on a work-stealing thread pool and report the
+// score distribution and turn time percentiles.  Game i uses seed + i, so
+// a run is reproducible for a given seed whatever the thread count.  With
+// several plugins every strategy plays the same seeds, their games
+// interleaved in one pool so they share the same warm-up and machine
+// load, and each is scored against the first.
+int main(int argc, char *argv[])
+{
+   int games = 1000;
+   int threads = 0;
+   unsigned seed = 1;
+   SearchMode mode = DIJKSTRA;
+   bool obstacles = false;
+   double density = OBSTACLE_DENSITY;
+   string logPrefix;
+   string replayPath;
+   vector<Contender> contenders;
+   int width = PLAYFIELD_WIDTH;
+   int height = PLAYFIELD_HEIGHT;
+   int opt;
+
+   while ((opt = getopt(argc, argv, "g:j:s:m:W:H:od:l:r:p:")) != -1)
+   {
+      switch (opt)
+      {
+         case 'g': games = atoi(optarg); break;
+         case 'j': threads = atoi(optarg); break;
+         case 's': seed = strtoul(optarg, NULL, 10); break;
+         case 'W': width = atoi(optarg); break;
+         case 'H': height = atoi(optarg); break;
+         case 'o': obstacles = true; break;
+         case 'l': logPrefix = optarg; break;
+         case 'r': replayPath = optarg; break;
+         case 'd': density = atof(optarg); obstacles = true; break;
+         case 'p': if (!addPlugin(optarg, contenders)) return 1; break;
+         case 'm':
+            if (strcmp(optarg, "dijkstra") == 0) mode = DIJKSTRA;
+            else if (strcmp(optarg, "astar") == 0) mode = ASTAR;
+            else if (strcmp(optarg, "dstar") == 0) mode = DSTAR_LITE;
+            else if (strcmp(optarg, "survival") == 0) mode = SURVIVAL;
+            else if (strcmp(optarg, "hamilton") == 0) mode = HAMILTON;
+            else { usage(argv[0]); return 1; }
+            break;
+         default: usage(argv[0]); return 1;
+      }
+   }
+   if (games <= 0 || width < 2 || height < 2 || density < 0 || density >= 1)
+   {
+      usage(argv[0]);
+      return 1;
+   }
+
+   if (contenders.empty())
+   {
+      Contender c = {"player", mode, NULL, ""};
+      contenders.push_back(c);
+   }
+   int count = contenders.size();
+
+   // Game i of contender c is result i * count + c
+   vector<GameResult> results(games * count);
+   steady_clock::time_point start = steady_clock::now();
+   int threadCount;
+   {
+      ThreadPool pool(threads);
+      threadCount = pool.size();
+      for (int i = 0 ; i < games ; i++)
+      {
+         for (int c = 0 ; c < count ; c++)
+         {
+            GameResult *result = &results[i * count + c];
+            const Contender *contender = &contenders[c];
+            unsigned gameSeed = seed + i;
+            string logSuffix = count > 1 ? "." + to_string(c) : "";
+            pool.submit([=] {
+               playGame(gameSeed, contender, width, height, obstacles,
+                        density, logPrefix, logSuffix, !replayPath.empty(),
+                        result);
+            });
+         }
+      }
+      pool.wait();
+   }
+   double elapsed = duration<double>(steady_clock::now() - start).count();
+
+   // Replays go to the file in seed order, whatever order games finished
+   if (!replayPath.empty())
+   {
+      ofstream out(replayPath, ios::binary);
+      for (GameResult &r : results)
+         out.write(r.replay.data(), r.replay.size());
+      if (!out) cerr << "Cannot write " << replayPath << endl;
+   }
+
+   size_t turns = 0;
+   for (GameResult &r : results) turns += r.turnTimes.size();
+
+   cout << fixed << setprecision(2);
+   cout << "Games: " << games * count << " on " << threadCount
+        << " threads in " << elapsed << " s (" << games * count / elapsed
+        << " games/s, " << turns / elapsed << " turns/s)" << endl;
+
+   for (int c = 0 ; c < count ; c++)
+   {
+      vector<GameResult *> own;
+      for (int i = 0 ; i < games ; i++)
+         own.push_back(&results[i * count + c]);
+      if (count > 1)
+         cout << endl << "Strategy " << contenders[c].name << endl;
+      report(own);
+   }
+
+   // Head to head on each seed against the first strategy
+   if (count > 1)
+      cout << endl << "Against " << contenders[0].name << ":" << endl;
+   for (int c = 1 ; c < count ; c++)
+   {
+      int wins = 0, ties = 0, losses = 0;
+      double difference = 0.0;
+      for (int i = 0 ; i < games ; i++)
+      {
+         int score = results[i * count + c].score;
+         int first = results[i * count].score;
+         if (score > first) wins++;
+         else if (score == first) ties++;
+         else losses++;
+         difference += score - first;
+      }
+      cout << "  " << contenders[c].name << ": " << wins << " wins, " << ties
+           << " ties, " << losses << " losses, mean score "
+           << showpos << difference / games << noshowpos << endl;
+   }
+
+   for (Contender &c : contenders) delete c.library;
+   return 0;
+}
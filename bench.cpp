@@ -0,0 +1,287 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <unistd.h>
+#include <vector>
+#include "game.h"
+#include "player.h"
+#include "profile.h"
+#include "snakeGraph.h"
+#include "cc.h"
+#include "biconnected.h"
+#include "weightedGraph.h"
+#include "dijkstra.h"
+
+using namespace std;
+using namespace std::chrono;
+
+// Every allocation in the process goes through these, so the number made
+// during a turn is the difference between two reads of the counter
+static atomic<long> allocationCount(0);
+
+void *operator new(size_t size)
+{
+   allocationCount.fetch_add(1, memory_order_relaxed);
+   void *p = malloc(size ? size : 1);
+   if (!p) throw bad_alloc();
+   return p;
+}
+
+void operator delete(void *p) noexcept { free(p); }
+
+void *operator new[](size_t size) { return operator new(size); }
+
+void operator delete[](void *p) noexcept { free(p); }
+
+// The summary of one measured quantity over all turns
+struct Stat
+{
+   string name;
+   double mean, p50, p99, max;
+};
+
+static Stat summarize(const string &name, vector<double> values)
+{
+   Stat s = {name, 0.0, 0.0, 0.0, 0.0};
+   if (values.empty()) return s;
+
+   sort(values.begin(), values.end());
+   for (double v : values) s.mean += v;
+   s.mean /= values.size();
+   s.p50 = values[(size_t)(0.50 * (values.size() - 1) + 0.5)];
+   s.p99 = values[(size_t)(0.99 * (values.size() - 1) + 0.5)];
+   s.max = values.back();
+   return s;
+}
+
+static void usage(const char *name)
+{
+   cerr << "Usage: " << name << " [-g games] [-s seed]"
+        << " [-m dijkstra|astar|dstar|survival|hamilton]"
+        << " [-W width] [-H height] [-o]"
+        << " [-d density] [-f csv|json] [-t]" << endl;
+   cerr << "  -o places obstacles on every playfield" << endl;
+   cerr << "  -d sets the fraction of cells that are obstacles, and implies -o"
+        << endl;
+   cerr << "  -t measures graph traversals on every board instead of turns"
+        << endl;
+}
+
+// Run f and add its time in microseconds and the allocations it made to
+// the two lists
+template<class F>
+static void measure(F f, vector<double> &times, vector<double> &allocations)
+{
+   long allocated = allocationCount.load(memory_order_relaxed);
+   steady_clock::time_point start = steady_clock::now();
+   f();
+   steady_clock::time_point end = steady_clock::now();
+   allocations.push_back(allocationCount.load(memory_order_relaxed) -
+                         allocated);
+   times.push_back(duration<double, micro>(end - start).count());
+}
+
+// Build both graph types from the board after every turn and time the
+// traversals the game runs on them: walking all adjacency, connected
+// components by breadth-first and by depth-first search, articulation
+// points and a full Dijkstra search, both on the stored graph and on an
+// ImplicitGrid over the board.  The two component searches must agree.  The
+// searches reuse one object each, as the player does, so once their
+// tables have grown a traversal should not allocate at all.
+static vector<Stat> traversals(int games, unsigned seed, SearchMode mode,
+                               int width, int height, bool obstacles,
+                               double density, long &boards)
+{
+   const char *names[] = {"adjacency", "edges", "cc", "cc dfs",
+                          "biconnected", "dijkstra", "dijkstra implicit"};
+   const int kinds = 7;
+   const int *costs = CellWeights::forSize(width, height).data();
+   vector<double> times[kinds], allocations[kinds];
+   CC cc;
+   Biconnected bicon;
+   DijkstraSP sp;
+   long sum = 0;
+   int disagreements = 0;
+
+   boards = 0;
+   for (int i = 0 ; i < games ; i++)
+   {
+      Playfield *playfield = new Playfield(width, height, obstacles,
+                                           seed + i, density);
+      Game game(new Player(mode), playfield);
+
+      while (!game.isGameOver())
+      {
+         const GridCell *grid = playfield->getGrid();
+         SnakeGraph snake(grid, width, height);
+         WeightedGraph weighted(grid, width, height);
+         int head = playfield->getView().head;
+         boards++;
+
+         measure([&] {
+            for (int v : snake.Vertices())
+               for (int w : snake.adj(v)) sum += w;
+         }, times[0], allocations[0]);
+         measure([&] {
+            for (Edge e : weighted.Edges()) sum += e.Weight();
+         }, times[1], allocations[1]);
+         measure([&] { cc.analyze(&snake); }, times[2], allocations[2]);
+         int components = cc.count();
+         measure([&] { cc.analyze(&snake, true); }, times[3],
+                 allocations[3]);
+         if (cc.count() != components) disagreements++;
+         measure([&] { bicon.analyze(&snake); }, times[4], allocations[4]);
+         measure([&] { sp.search(&weighted, head); }, times[5],
+                 allocations[5]);
+         measure([&] {
+            ImplicitGrid<> g(GridDims(width, height), grid, TAIL_VALUE, costs);
+            sp.searchGrid(g, head);
+         }, times[6], allocations[6]);
+
+         game.makeMove();
+      }
+   }
+
+   vector<Stat> stats;
+   for (int k = 0 ; k < kinds ; k++)
+      stats.push_back(summarize(string(names[k]), times[k]));
+   for (int k = 0 ; k < kinds ; k++)
+      stats.push_back(summarize(string(names[k]) + " allocations",
+                                allocations[k]));
+   if (disagreements > 0)
+      cerr << "Depth-first and breadth-first components differ on "
+           << disagreements << " boards" << endl;
+   // Keep the adjacency walks from being optimised away
+   if (sum == -1) cerr << sum << endl;
+   return stats;
+}
+
+// Print the stats as CSV or as one JSON object
+static void print(const vector<Stat> &stats, bool json, int games,
+                  long turns, int width, int height)
+{
+   cout << fixed << setprecision(3);
+   if (json)
+   {
+      cout << "{\"games\": " << games << ", \"turns\": " << turns
+           << ", \"width\": " << width << ", \"height\": " << height
+           << ", \"stats\": {";
+      for (size_t i = 0 ; i < stats.size() ; i++)
+         cout << (i ? ", " : "") << "\"" << stats[i].name << "\": {"
+              << "\"mean\": " << stats[i].mean << ", \"p50\": "
+              << stats[i].p50 << ", \"p99\": " << stats[i].p99
+              << ", \"max\": " << stats[i].max << "}";
+      cout << "}}" << endl;
+   }
+   else
+   {
+      cout << "metric,mean,p50,p99,max" << endl;
+      for (const Stat &s : stats)
+         cout << s.name << "," << s.mean << "," << s.p50 << "," << s.p99
+              << "," << s.max << endl;
+   }
+}
+
+// Play seeded games on one thread and break every turn down into the
+// phases of Game::makeMove.  Times are in microseconds.  Games that are
+// seeded the same play the same moves, so two builds can be compared on
+// identical work.
+int main(int argc, char *argv[])
+{
+   int games = 100;
+   unsigned seed = 1;
+   SearchMode mode = DIJKSTRA;
+   bool obstacles = false;
+   double density = OBSTACLE_DENSITY;
+   bool json = false;
+   bool traverse = false;
+   int width = PLAYFIELD_WIDTH;
+   int height = PLAYFIELD_HEIGHT;
+   int opt;
+
+   while ((opt = getopt(argc, argv, "g:s:m:W:H:od:f:t")) != -1)
+   {
+      switch (opt)
+      {
+         case 'g': games = atoi(optarg); break;
+         case 's': seed = strtoul(optarg, NULL, 10); break;
+         case 'W': width = atoi(optarg); break;
+         case 'H': height = atoi(optarg); break;
+         case 'o': obstacles = true; break;
+         case 'd': density = atof(optarg); obstacles = true; break;
+         case 't': traverse = true; break;
+         case 'm':
+            if (strcmp(optarg, "dijkstra") == 0) mode = DIJKSTRA;
+            else if (strcmp(optarg, "astar") == 0) mode = ASTAR;
+            else if (strcmp(optarg, "dstar") == 0) mode = DSTAR_LITE;
+            else if (strcmp(optarg, "survival") == 0) mode = SURVIVAL;
+            else if (strcmp(optarg, "hamilton") == 0) mode = HAMILTON;
+            else { usage(argv[0]); return 1; }
+            break;
+         case 'f':
+            if (strcmp(optarg, "csv") == 0) json = false;
+            else if (strcmp(optarg, "json") == 0) json = true;
+            else { usage(argv[0]); return 1; }
+            break;
+         default: usage(argv[0]); return 1;
+      }
+   }
+   if (games <= 0 || width < 2 || height < 2 || density < 0 || density >= 1)
+   {
+      usage(argv[0]);
+      return 1;
+   }
+
+   if (traverse)
+   {
+      long boards;
+      vector<Stat> stats = traversals(games, seed, mode, width, height,
+                                      obstacles, density, boards);
+      print(stats, json, games, boards, width, height);
+      return 0;
+   }
+
+   vector<double> phaseTimes[PHASE_COUNT];
+   vector<double> turnTimes, allocations, nodes;
+   TurnProfile profile;
+   setActiveProfile(&profile);
+
+   for (int i = 0 ; i < games ; i++)
+   {
+      Game game(new Player(mode), width, height, obstacles, seed + i,
+                density);
+
+      while (!game.isGameOver())
+      {
+         profile.clear();
+         long allocated = allocationCount.load(memory_order_relaxed);
+         steady_clock::time_point start = steady_clock::now();
+         game.makeMove();
+         steady_clock::time_point end = steady_clock::now();
+         profile.allocations =
+            allocationCount.load(memory_order_relaxed) - allocated;
+
+         turnTimes.push_back(duration<double, micro>(end - start).count());
+         for (int p = 0 ; p < PHASE_COUNT ; p++)
+            phaseTimes[p].push_back(profile.seconds[p] * 1e6);
+         allocations.push_back(profile.allocations);
+         nodes.push_back(profile.nodesExpanded);
+      }
+   }
+   setActiveProfile(nullptr);
+
+   vector<Stat> stats;
+   stats.push_back(summarize("turn", turnTimes));
+   for (int p = 0 ; p < PHASE_COUNT ; p++)
+      stats.push_back(summarize(PhaseNames[p], phaseTimes[p]));
+   stats.push_back(summarize("allocations", allocations));
+   stats.push_back(summarize("nodes", nodes));
+
+   print(stats, json, games, turnTimes.size(), width, height);
+   return 0;
+}
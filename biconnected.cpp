@@ -4,58 +4,80 @@
 #include "biconnected.h"
 #include <iostream>
 
-Biconnected::Biconnected(SnakeGraph *G) : Time(0)
+// Searches a grid from every open cell not yet reached, with the
+// dimension type picked by withGridDims
+struct Biconnected::GridSearch
 {
-   // Set all the parents to be NO_PARENT
+   ArticulationTables &tables;
+   const GridCell *grid;
+   GridCell blocked;
+
+   template <class Dims> void operator()(const Dims &dims)
+   {
+      ImplicitGrid<Dims> g(dims, grid, blocked);
+      for (int v = 0 ; v < dims.cells() ; v++)
+         if (g.open(v) && tables.time[v] < 0)
+            gridArticulation(g, v, tables);
+   }
+};
+
+Biconnected::Biconnected()
+{
+   tables.clock = tables.components = 0;
+}
+
+Biconnected::Biconnected(const SnakeGraph *G) : Biconnected()
+{
+   analyze(G);
+}
+
+// Analyze a SnakeGraph, reading the neighbour lists it already keeps
+// in one array
+void Biconnected::analyze(const SnakeGraph *G)
+{
+   tables.reset(G->cells());
    for (int v : G->Vertices())
-      parent[v] = NO_PARENT;
+      if (tables.time[v] < 0)
+         gridArticulation(*G, v, tables);
+}
 
-   // arbitrarily start at the first vertex in the vertex list
-   dfs(G, *((G->Vertices()).begin())); 
+// Analyze the open cells of a width x height grid, those that do not
+// hold blocked, with edges between side by side cells.  Nothing is
+// built; neighbours are worked out from the cell index.
+void Biconnected::analyze(const GridCell *grid, int width, int height,
+                          GridCell blocked)
+{
+   tables.reset(width * height);
+   GridSearch search = {tables, grid, blocked};
+   withGridDims(width, height, search);
 }
 
 // Return the set of articulation nodes
-set<int> Biconnected::articulationNodes() { return articulationPoints ; }
-
-// Mark the visited and low times for each vertex in the graph using
-// DFS.  Using the rules for articulation points, mark any vertex
-// that is an articulation node and add it to the articulationPoints
-// set
-// @param[in] : G - An unweighted graph
-// @param[in] : v - The vertex to perform DFS from
-void Biconnected::dfs(SnakeGraph *G, int v)
-{
-   int childCount = 0;
-   bool isArticulation = false;
-
-   // Set visited, time and loTime.  loTime may be changed later
-   visited[v] = true;
-   time[v] = Time;
-   loTime[v] = Time++;
-   for (int w : G->adj(v))
-   {
-      if (w == parent[v]) continue; // parents are not back edges
-      if (!visited[w])
-      {
-         parent[w] = v;
-         childCount++;
-         dfs(G, w);
-         if (time[v] <= loTime[w])
-            isArticulation = true;
-         else
-         {
-            loTime[v] = (loTime[v] < loTime[w]) ? loTime[v] : loTime[w];
-         }
-      }
-      else // back edges
-      {
-         loTime[v] = (time[w] < loTime[v]) ? time[w] : loTime[v];
-      }
-   }
-   // Root nodes with 2 or more independent children or
-   // Nodes with visit times equal or before adjacent node
-   //  lo times are articulation points
-   if ((parent[v] == NO_PARENT && childCount >= 2) ||
-       (parent[v] != NO_PARENT && isArticulation))
-      articulationPoints.insert(v);
+set<int> Biconnected::articulationNodes()
+{
+   return set<int>(tables.points.begin(), tables.points.end());
+}
+
+// Number of articulation nodes, without building a set
+int Biconnected::articulationCount() const
+{
+   return tables.points.size();
+}
+
+bool Biconnected::isArticulation(int v) const
+{
+   return tables.articulation[v];
+}
+
+// Number of connected components
+int Biconnected::count() const { return tables.components; }
+
+// Which connected component a vertex is in, or -1 if it is not a vertex
+int Biconnected::id(int v) const { return tables.component[v]; }
+
+// Return whether two vertices are in the same connected component
+bool Biconnected::connected(int v, int w) const
+{
+   return tables.component[v] >= 0 &&
+          tables.component[v] == tables.component[w];
 }
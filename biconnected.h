@@ -3,31 +3,39 @@
  ***********************************************************************/
 #ifndef BICONNECTED_H
 #define BICONNECTED_H
+#include <set>
+#include <vector>
 #include "snakeGraph.h"
-
-#define NO_PARENT -1 // Dangerous since we might have negative numbers for nodes
+#include "graphSearch.h"
 
 /********************************************************************//**
  * @class Biconnected
  *
- * A class that uses the Graph API representation of a graph to
- * determine if a graph is biconnected
+ * Finds the articulation points and the connected components of a
+ * graph in one depth-first search, with gridArticulation from
+ * graphSearch.h.  The search keeps its own stack, so it works on boards
+ * of any size, and all its state is in arrays indexed by vertex.  An
+ * object can be reused for many graphs; once its arrays have grown to
+ * the largest graph it does not allocate again.
  **********************************************************************/
 class Biconnected
 {
-   // Could also put these in an info structure instead of having all the
-   // parallel maps
-   std::map<int, bool> visited;
-   std::map<int, int> time;
-   std::map<int, int> loTime;
-   std::map<int, int> parent;
-   std::set<int> articulationPoints;
-   int Time;
+   ArticulationTables tables;
+
+   struct GridSearch;
 public:
-   Biconnected(SnakeGraph *G);
-    
-   void dfs(SnakeGraph *, int);
+   Biconnected();
+   Biconnected(const SnakeGraph *G);
+
+   void analyze(const SnakeGraph *);
+   void analyze(const GridCell *, int, int, GridCell blocked);
 
    set<int> articulationNodes();
+   int articulationCount() const;
+   bool isArticulation(int) const;
+
+   int count() const;
+   int id(int) const;
+   bool connected(int, int) const;
 };
 #endif
@@ -0,0 +1,499 @@
+/********************************************************************//**
+ * @file
+ ***********************************************************************/
+#include "bitboard.h"
+#include <cstddef>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// Several words side by side, for the fills that work on many rows at
+// once.  The compiler turns the operators into AVX2 or SSE2 instructions.
+#if defined(__AVX2__)
+#define LANE_WORDS 4
+#elif defined(__SSE2__)
+#define LANE_WORDS 2
+#else
+#define LANE_WORDS 1
+#endif
+typedef uint64_t Lanes __attribute__((vector_size(LANE_WORDS * 8)));
+
+static Lanes loadLanes(const uint64_t *p)
+{
+   Lanes v;
+   __builtin_memcpy(&v, p, sizeof v);
+   return v;
+}
+
+static void storeLanes(uint64_t *p, Lanes v)
+{
+   __builtin_memcpy(p, &v, sizeof v);
+}
+
+static bool anyLane(Lanes v)
+{
+   uint64_t any = 0;
+   for (int i = 0 ; i < LANE_WORDS ; i++) any |= v[i];
+   return any != 0;
+}
+
+// Grow the set bits of gen along a word towards the low bits, through
+// the bits of open.  Each step doubles the distance covered, so six
+// steps fill a whole 64-bit word.  Works on one word or on Lanes.
+template <class Word>
+static Word fillDown(Word gen, Word open)
+{
+   gen |= open & (gen >> 1);   open &= open >> 1;
+   gen |= open & (gen >> 2);   open &= open >> 2;
+   gen |= open & (gen >> 4);   open &= open >> 4;
+   gen |= open & (gen >> 8);   open &= open >> 8;
+   gen |= open & (gen >> 16);  open &= open >> 16;
+   gen |= open & (gen >> 32);
+   return gen;
+}
+
+// Grow the set bits of gen to cover every run of open bits they are in
+// or next to.  Towards the high bits this is an addition: adding a seed
+// to its run of ones carries through the rest of the run.
+template <class Word>
+static Word fillRuns(Word gen, Word open)
+{
+   gen |= open & ((gen << 1) | (gen >> 1));
+   Word seeds = gen & open;
+   gen |= ((open + seeds) ^ open) & open;
+   return fillDown(gen, open);
+}
+
+// fillRuns on rows [0, n) of one-word rows.  last holds each row as the
+// previous call left it; rows that have not changed since are already
+// filled and are skipped, LANE_WORDS rows at a time.  lo and hi are set
+// to the first and last rows the call changed.  Returns whether it
+// changed any.
+static bool fillAllRuns(uint64_t *gen, const uint64_t *open, uint64_t *last,
+                        int n, int &lo, int &hi)
+{
+   int r = 0;
+
+   lo = n;
+   hi = -1;
+   for ( ; r + LANE_WORDS <= n ; r += LANE_WORDS)
+   {
+      Lanes g = loadLanes(gen + r);
+      if (!anyLane(g ^ loadLanes(last + r))) continue;
+      Lanes filled = fillRuns(g, loadLanes(open + r));
+      storeLanes(gen + r, filled);
+      storeLanes(last + r, filled);
+      if (anyLane(filled ^ g))
+      {
+         if (lo == n) lo = r;
+         hi = r + LANE_WORDS - 1;
+      }
+   }
+   for ( ; r < n ; r++)
+      if (gen[r] != last[r])
+      {
+         uint64_t filled = fillRuns(gen[r], open[r]);
+         if (filled != gen[r])
+         {
+            if (lo == n) lo = r;
+            hi = r;
+         }
+         last[r] = gen[r] = filled;
+      }
+   return hi >= 0;
+}
+
+// Number of set bits in n words.  A popcount instruction is not part of
+// the base instruction set, so the bits of each byte are added up in
+// parallel and the bytes of each word summed with psadbw.
+static int countBits(const uint64_t *words, int n)
+{
+   uint64_t total = 0;
+   int i = 0;
+
+#if defined(__AVX2__) || defined(__SSE2__)
+   const uint64_t m1 = 0x5555555555555555ULL, m2 = 0x3333333333333333ULL;
+   const uint64_t m4 = 0x0F0F0F0F0F0F0F0FULL;
+   Lanes sum = {};
+
+   for ( ; i + LANE_WORDS <= n ; i += LANE_WORDS)
+   {
+      Lanes v = loadLanes(words + i);
+      v -= (v >> 1) & m1;
+      v = (v & m2) + ((v >> 2) & m2);
+      v = (v + (v >> 4)) & m4;
+#if defined(__AVX2__)
+      sum += (Lanes) _mm256_sad_epu8((__m256i) v, _mm256_setzero_si256());
+#else
+      sum += (Lanes) _mm_sad_epu8((__m128i) v, _mm_setzero_si128());
+#endif
+   }
+   for (int k = 0 ; k < LANE_WORDS ; k++)
+      total += sum[k];
+#endif
+   for ( ; i < n ; i++)
+      total += __builtin_popcountll(words[i]);
+   return total;
+}
+
+// Grow the set bits of one-word rows [0, n) along the columns through
+// open, with a sweep down and then a sweep up, each row taking from the
+// row before it in the sweep.  Only two operations per row wait on the
+// row before, so this is cheap next to filling along the rows.  If the
+// columns were already filled before rows lo..hi changed, the sweeps
+// start at those rows and stop at the first unchanged row past them.
+static void fillColumns(uint64_t *gen, const uint64_t *open, int n, int lo,
+                        int hi)
+{
+   uint64_t carry = lo > 0 ? gen[lo - 1] : 0;
+   for (int r = lo ; r < n ; r++)
+   {
+      uint64_t filled = gen[r] | (open[r] & carry);
+      if (filled == gen[r] && r > hi) break;
+      gen[r] = carry = filled;
+      if (r > hi) hi = r;
+   }
+
+   carry = hi < n - 1 ? gen[hi + 1] : 0;
+   for (int r = hi ; r >= 0 ; r--)
+   {
+      uint64_t filled = gen[r] | (open[r] & carry);
+      if (filled == gen[r] && r < lo) break;
+      gen[r] = carry = filled;
+   }
+}
+
+// Bits for up to 64 cells of a row: set where the cell is not blocked
+static uint64_t packCells(const GridCell *cells, int n, GridCell blocked)
+{
+   uint64_t word = 0;
+   int k = 0;
+
+#if defined(__AVX2__)
+   __m256i wall = _mm256_set1_epi8((char) blocked);
+   for ( ; k + 32 <= n ; k += 32)
+   {
+      __m256i v = _mm256_loadu_si256((const __m256i *) (cells + k));
+      uint32_t hit = _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, wall));
+      word |= (uint64_t) (uint32_t) ~hit << k;
+   }
+#endif
+#if defined(__SSE2__)
+   __m128i wall16 = _mm_set1_epi8((char) blocked);
+   for ( ; k + 16 <= n ; k += 16)
+   {
+      __m128i v = _mm_loadu_si128((const __m128i *) (cells + k));
+      uint32_t hit = _mm_movemask_epi8(_mm_cmpeq_epi8(v, wall16));
+      word |= (uint64_t) (~hit & 0xFFFF) << k;
+   }
+#endif
+   for ( ; k < n ; k++)
+      if (cells[k] != blocked)
+         word |= (uint64_t) 1 << k;
+   return word;
+}
+
+Bitboard::Bitboard() : width(0), height(0), rowWords(0) { }
+
+Bitboard::Bitboard(int w, int h) : Bitboard() { resize(w, h); }
+
+// Change the board size; every cell is cleared
+void Bitboard::resize(int w, int h)
+{
+   width = w;
+   height = h;
+   rowWords = (w + 63) / 64;
+   bits.assign((h + 2) * rowWords, 0);
+   dirty.assign(h + 2, 0);
+   scratch.assign(rowWords == 1 ? h : 0, 0);
+}
+
+// Set every cell of a width x height grid that does not hold blocked
+void Bitboard::fromGrid(const GridCell *grid, GridCell blocked)
+{
+   for (int r = 0 ; r < height ; r++)
+   {
+      uint64_t *words = row(r);
+      const GridCell *cells = grid + r * width;
+      for (int j = 0 ; j < rowWords ; j++)
+      {
+         int n = width - j * 64;
+         words[j] = packCells(cells + j * 64, n < 64 ? n : 64, blocked);
+      }
+   }
+}
+
+void Bitboard::clear() { bits.assign(bits.size(), 0); }
+
+bool Bitboard::test(int cell) const
+{
+   int r = cell / width, c = cell % width;
+   return (row(r)[c / 64] >> (c % 64)) & 1;
+}
+
+void Bitboard::set(int cell)
+{
+   int r = cell / width, c = cell % width;
+   row(r)[c / 64] |= (uint64_t) 1 << (c % 64);
+}
+
+void Bitboard::reset(int cell)
+{
+   int r = cell / width, c = cell % width;
+   row(r)[c / 64] &= ~((uint64_t) 1 << (c % 64));
+}
+
+// Number of set cells
+int Bitboard::count() const
+{
+   return countBits(bits.data(), bits.size());
+}
+
+bool Bitboard::empty() const
+{
+   for (uint64_t word : bits)
+      if (word) return false;
+   return true;
+}
+
+// The lowest numbered set cell, or -1 if there are none
+int Bitboard::first() const
+{
+   for (int r = 0 ; r < height ; r++)
+      for (int j = 0 ; j < rowWords ; j++)
+         if (row(r)[j])
+            return r * width + j * 64 + __builtin_ctzll(row(r)[j]);
+   return -1;
+}
+
+int Bitboard::getWidth() const { return width; }
+
+int Bitboard::getHeight() const { return height; }
+
+// The whole-board operations walk every word including the empty rows,
+// which stay empty because both operands have them empty
+Bitboard &Bitboard::operator&=(const Bitboard &other)
+{
+   uint64_t *a = bits.data();
+   const uint64_t *b = other.bits.data();
+   size_t n = bits.size(), i = 0;
+
+#if defined(__AVX2__)
+   for ( ; i + 4 <= n ; i += 4)
+      _mm256_storeu_si256((__m256i *) (a + i), _mm256_and_si256(
+         _mm256_loadu_si256((const __m256i *) (a + i)),
+         _mm256_loadu_si256((const __m256i *) (b + i))));
+#elif defined(__SSE2__)
+   for ( ; i + 2 <= n ; i += 2)
+      _mm_storeu_si128((__m128i *) (a + i), _mm_and_si128(
+         _mm_loadu_si128((const __m128i *) (a + i)),
+         _mm_loadu_si128((const __m128i *) (b + i))));
+#endif
+   for ( ; i < n ; i++)
+      a[i] &= b[i];
+   return *this;
+}
+
+Bitboard &Bitboard::operator|=(const Bitboard &other)
+{
+   uint64_t *a = bits.data();
+   const uint64_t *b = other.bits.data();
+   size_t n = bits.size(), i = 0;
+
+#if defined(__AVX2__)
+   for ( ; i + 4 <= n ; i += 4)
+      _mm256_storeu_si256((__m256i *) (a + i), _mm256_or_si256(
+         _mm256_loadu_si256((const __m256i *) (a + i)),
+         _mm256_loadu_si256((const __m256i *) (b + i))));
+#elif defined(__SSE2__)
+   for ( ; i + 2 <= n ; i += 2)
+      _mm_storeu_si128((__m128i *) (a + i), _mm_or_si128(
+         _mm_loadu_si128((const __m128i *) (a + i)),
+         _mm_loadu_si128((const __m128i *) (b + i))));
+#endif
+   for ( ; i < n ; i++)
+      a[i] |= b[i];
+   return *this;
+}
+
+// Clear every cell that is set in other
+Bitboard &Bitboard::andNot(const Bitboard &other)
+{
+   uint64_t *a = bits.data();
+   const uint64_t *b = other.bits.data();
+   size_t n = bits.size(), i = 0;
+
+#if defined(__AVX2__)
+   for ( ; i + 4 <= n ; i += 4)
+      _mm256_storeu_si256((__m256i *) (a + i), _mm256_andnot_si256(
+         _mm256_loadu_si256((const __m256i *) (b + i)),
+         _mm256_loadu_si256((const __m256i *) (a + i))));
+#elif defined(__SSE2__)
+   for ( ; i + 2 <= n ; i += 2)
+      _mm_storeu_si128((__m128i *) (a + i), _mm_andnot_si128(
+         _mm_loadu_si128((const __m128i *) (b + i)),
+         _mm_loadu_si128((const __m128i *) (a + i))));
+#endif
+   for ( ; i < n ; i++)
+      a[i] &= ~b[i];
+   return *this;
+}
+
+bool Bitboard::operator==(const Bitboard &other) const
+{
+   return width == other.width && height == other.height &&
+          bits == other.bits;
+}
+
+// Add the cells of open next to this row's set cells, then spread along
+// the row.  The row is filled word by word from left to right, carrying
+// the top bit of each word into the next, and then back from right to
+// left, which covers every run of open cells whatever word it starts in.
+// A word that gains nothing from its neighbours is already filled and is
+// skipped, unless force is set for the first pass over new seeds.
+// Returns whether the row changed.
+bool Bitboard::fillRow(int r, const Bitboard &open, bool force)
+{
+   uint64_t *words = row(r);
+   const uint64_t *above = words - rowWords;
+   const uint64_t *below = words + rowWords;
+   const uint64_t *o = open.row(r);
+   bool changed = false;
+   uint64_t carry = 0;
+
+   for (int j = 0 ; j < rowWords ; j++)
+   {
+      uint64_t gen = words[j] | ((above[j] | below[j] | carry) & o[j]);
+      if (gen != words[j] || (force && gen))
+      {
+         gen = fillRuns(gen, o[j]);
+         changed |= gen != words[j];
+         words[j] = gen;
+      }
+      carry = words[j] >> 63;
+   }
+
+   carry = 0;
+   for (int j = rowWords - 1 ; j >= 0 && rowWords > 1 ; j--)
+   {
+      uint64_t gen = words[j] | ((carry << 63) & o[j]);
+      if (gen != words[j])
+      {
+         words[j] = fillRuns(gen, o[j]);
+         changed = true;
+      }
+      carry = words[j] & 1;
+   }
+   return changed;
+}
+
+// fill for boards with one word per row.  The columns are filled first,
+// then each round fills along every row, all rows at once, and then
+// along the columns from the rows that changed.  When the rows add
+// nothing the columns are already full too, so an open board takes one
+// round.
+void Bitboard::fillWords(const Bitboard &open)
+{
+   uint64_t *gen = row(0);
+   const uint64_t *o = open.row(0);
+   int lo, hi;
+
+   scratch.assign(height, 0);
+   fillColumns(gen, o, height, 0, height - 1);
+   while (fillAllRuns(gen, o, scratch.data(), height, lo, hi))
+      fillColumns(gen, o, height, lo, hi);
+}
+
+// Grow the set cells through the set cells of open until nothing more
+// can be reached.  The rows are swept top to bottom and then bottom to
+// top, each row using the rows already updated in that sweep, so an
+// open region is filled in one pair of sweeps and only winding regions
+// need more.  A row is only visited when a row next to it has changed
+// since its last visit.  Cells already set stay set even if they are not
+// open, which lets a search start from the snake's head.
+void Bitboard::fill(const Bitboard &open)
+{
+   if (rowWords == 1)
+   {
+      fillWords(open);
+      return;
+   }
+
+   // dirty is offset by one so the rows past each edge can be marked
+   unsigned char *mark = &dirty[1];
+   bool changed = false;
+
+   for (int r = 0 ; r < height ; r++)
+      if (fillRow(r, open, true))
+         mark[r - 1] = mark[r + 1] = 1;
+
+   do
+   {
+      changed = false;
+      for (int r = 0 ; r < height ; r++)
+         if (mark[r])
+         {
+            mark[r] = 0;
+            if (fillRow(r, open, false))
+            {
+               mark[r - 1] = mark[r + 1] = 1;
+               changed = true;
+            }
+         }
+      for (int r = height - 1 ; r >= 0 ; r--)
+         if (mark[r])
+         {
+            mark[r] = 0;
+            if (fillRow(r, open, false))
+            {
+               mark[r - 1] = mark[r + 1] = 1;
+               changed = true;
+            }
+         }
+   } while (changed);
+
+   mark[-1] = mark[height] = 0;
+}
+
+// Number of groups of set cells connected through set cells
+int Bitboard::components() const
+{
+   Bitboard remaining = *this;
+   Bitboard region(width, height);
+   int count = 0;
+   int cell;
+
+   while ((cell = remaining.first()) >= 0)
+   {
+      region.clear();
+      region.set(cell);
+      region.fill(remaining);
+      remaining.andNot(region);
+      count++;
+   }
+   return count;
+}
+
+// Number of set cells that can be reached from cell moving only through
+// set cells.  The cell itself does not need to be set and is not
+// counted.  region is left holding the cells reached, plus cell; it is
+// resized to match if needed, so a caller that keeps it does not
+// allocate.
+int Bitboard::reachable(int cell, Bitboard &region) const
+{
+   if (region.width != width || region.height != height)
+      region.resize(width, height);
+   else
+      region.clear();
+
+   region.set(cell);
+   region.fill(*this);
+   return region.count() - 1;
+}
+
+int Bitboard::reachable(int cell) const
+{
+   Bitboard region;
+   return reachable(cell, region);
+}
@@ -0,0 +1,92 @@
+/********************************************************************//**
+ * @file
+ ***********************************************************************/
+#ifndef BITBOARD_H
+#define BITBOARD_H
+#include <cstdint>
+#include <vector>
+#include "gridCell.h"
+
+/********************************************************************//**
+ * @class Bitboard
+ *
+ * A set of playfield cells stored one bit per cell.  Each row is a whole
+ * number of 64-bit words, so 64 cells of a row are shifted and masked
+ * with a single operation, and there is an empty row above and below the
+ * board so the rows next to any row can be read without bounds checks.
+ * Bits past the width of a row are always zero.
+ *
+ * Whole-board operations use AVX2 or SSE2 when the compiler targets
+ * them and plain 64-bit words otherwise.  On boards up to 64 cells wide
+ * each row is one word, and fill works on all rows at once.
+ **********************************************************************/
+class Bitboard
+{
+   int width, height;
+   int rowWords;
+   std::vector<uint64_t> bits;
+   std::vector<unsigned char> dirty;   // rows fill still has to visit
+   std::vector<uint64_t> scratch;      // rows as the last run fill left them
+
+   uint64_t *row(int r) { return &bits[(r + 1) * rowWords]; }
+   const uint64_t *row(int r) const { return &bits[(r + 1) * rowWords]; }
+   bool fillRow(int, const Bitboard &, bool);
+   void fillWords(const Bitboard &);
+public:
+   Bitboard();
+   Bitboard(int w, int h);
+
+   void resize(int w, int h);
+   void fromGrid(const GridCell *, GridCell blocked);
+   void clear();
+
+   bool test(int cell) const;
+   void set(int cell);
+   void reset(int cell);
+
+   int count() const;
+   bool empty() const;
+   int first() const;
+   int getWidth() const;
+   int getHeight() const;
+
+   Bitboard &operator&=(const Bitboard &);
+   Bitboard &operator|=(const Bitboard &);
+   Bitboard &andNot(const Bitboard &);
+   bool operator==(const Bitboard &) const;
+
+   void fill(const Bitboard &open);
+   int components() const;
+   int reachable(int cell, Bitboard &region) const;
+   int reachable(int cell) const;
+};
+
+/********************************************************************//**
+ * @class BoardSnapshot
+ *
+ * A copy-on-write view of a bitboard for trying out moves.  Reads go to
+ * the shared board until the first change, which copies it into storage
+ * the snapshot keeps, so once that storage is sized a snapshot never
+ * allocates.  The shared board must not change while it is in use.
+ **********************************************************************/
+class BoardSnapshot
+{
+   const Bitboard *base;
+   Bitboard copy;
+   bool copied;
+
+   Bitboard &writable()
+   {
+      if (!copied) { copy = *base; copied = true; }
+      return copy;
+   }
+public:
+   BoardSnapshot() : base(nullptr), copied(false) { }
+
+   void take(const Bitboard &board) { base = &board; copied = false; }
+   const Bitboard &board() const { return copied ? copy : *base; }
+   bool test(int cell) const { return board().test(cell); }
+   void set(int cell) { if (!test(cell)) writable().set(cell); }
+   void reset(int cell) { if (test(cell)) writable().reset(cell); }
+};
+#endif
@@ -0,0 +1,118 @@
+/********************************************************************//**
+ * @file
+ ***********************************************************************/
+#define GL_GLEXT_PROTOTYPES
+#include "boardRenderer.h"
+#include <GL/glext.h>
+#include "graphics.h"
+
+// Vertices per cell: the outline quad then the fill quad
+#define CELL_VERTICES 8
+
+// Colour of each CellState, and of its outline
+static const Color CellColors[] = {GREEN, BLUE, BLACK, WHITE, RED, ORANGE};
+static const Color OutlineColors[] = {GREEN, BLACK, BLACK, BLACK, BLACK,
+                                      BLACK};
+
+// Add the corners of a rectangle to v, in quad order
+static void addQuad(std::vector<GLfloat> &v, float x1, float y1, float x2,
+                    float y2)
+{
+   GLfloat corners[] = {x1, y1, x2, y1, x2, y2, x1, y2};
+   v.insert(v.end(), corners, corners + 8);
+}
+
+// Lay a boardWidth x boardHeight board out over a pixelWidth x
+// pixelHeight viewport and load it into a vertex buffer, all clear
+BoardRenderer::BoardRenderer(int boardWidth, int boardHeight, int pixelWidth,
+                             int pixelHeight)
+   : width(boardWidth), cells(boardWidth * boardHeight),
+     dirtyFirst(0), dirtyLast(-1)
+{
+   int cellWidth = pixelWidth / width;
+   int cellHeight = pixelHeight / boardHeight;
+
+   positions.reserve(cells * CELL_VERTICES * 2);
+   for (int cell = 0 ; cell < cells ; cell++)
+   {
+      float x1 = cell % width * cellWidth, x2 = x1 + cellWidth;
+      float y1 = cell / width * cellHeight, y2 = y1 + cellHeight;
+      addQuad(positions, x1, y1, x2, y2);
+      addQuad(positions, x1 + 1, y1 + 1, x2 - 1, y2 - 1);
+   }
+   colors.resize(cells * CELL_VERTICES * 3);
+
+   size_t positionBytes = positions.size() * sizeof(GLfloat);
+   glGenBuffers(1, &buffer);
+   glBindBuffer(GL_ARRAY_BUFFER, buffer);
+   glBufferData(GL_ARRAY_BUFFER,
+                positionBytes + colors.size() * sizeof(GLfloat), NULL,
+                GL_DYNAMIC_DRAW);
+   glBufferSubData(GL_ARRAY_BUFFER, 0, positionBytes, positions.data());
+   glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+   for (int cell = 0 ; cell < cells ; cell++)
+      cellChanged(cell, CELL_CLEAR);
+}
+
+// Draw a playfield and follow its changes
+BoardRenderer::BoardRenderer(Playfield *playfield, int pixelWidth,
+                             int pixelHeight)
+   : BoardRenderer(playfield->getWidth(), playfield->getHeight(),
+                   pixelWidth, pixelHeight)
+{
+   playfield->setObserver(this);
+}
+
+BoardRenderer::~BoardRenderer()
+{
+   glDeleteBuffers(1, &buffer);
+}
+
+// Recolour a cell in memory; it is drawn by the next show()
+void BoardRenderer::cellChanged(int cell, CellState state)
+{
+   GLfloat *c = &colors[cell * CELL_VERTICES * 3];
+   for (int v = 0 ; v < CELL_VERTICES ; v++)
+   {
+      const float *rgb = Colors[v < 4 ? OutlineColors[state] :
+                                        CellColors[state]];
+      *c++ = rgb[0];
+      *c++ = rgb[1];
+      *c++ = rgb[2];
+   }
+
+   if (dirtyFirst > dirtyLast)
+      dirtyFirst = dirtyLast = cell;
+   else if (cell < dirtyFirst)
+      dirtyFirst = cell;
+   else if (cell > dirtyLast)
+      dirtyLast = cell;
+}
+
+// Upload the colours that changed and draw the whole board
+void BoardRenderer::show()
+{
+   size_t positionBytes = positions.size() * sizeof(GLfloat);
+   size_t cellBytes = CELL_VERTICES * 3 * sizeof(GLfloat);
+
+   glBindBuffer(GL_ARRAY_BUFFER, buffer);
+   if (dirtyFirst <= dirtyLast)
+   {
+      glBufferSubData(GL_ARRAY_BUFFER, positionBytes + dirtyFirst * cellBytes,
+                      (dirtyLast - dirtyFirst + 1) * cellBytes,
+                      &colors[dirtyFirst * CELL_VERTICES * 3]);
+      dirtyFirst = 0;
+      dirtyLast = -1;
+   }
+
+   glEnableClientState(GL_VERTEX_ARRAY);
+   glEnableClientState(GL_COLOR_ARRAY);
+   glVertexPointer(2, GL_FLOAT, 0, (const GLvoid *)0);
+   glColorPointer(3, GL_FLOAT, 0, (const GLvoid *)positionBytes);
+   glDrawArrays(GL_QUADS, 0, cells * CELL_VERTICES);
+   glDisableClientState(GL_COLOR_ARRAY);
+   glDisableClientState(GL_VERTEX_ARRAY);
+   glBindBuffer(GL_ARRAY_BUFFER, 0);
+   glFlush();
+}
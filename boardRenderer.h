@@ -0,0 +1,40 @@
+/********************************************************************//**
+ * @file
+ ***********************************************************************/
+#ifndef BOARDRENDERER_H
+#define BOARDRENDERER_H
+#include <vector>
+#include <GL/gl.h>
+#include "playfield.h"
+
+/********************************************************************//**
+ * @class BoardRenderer
+ *
+ * Draws a playfield with OpenGL from a vertex buffer that holds the whole
+ * board.  Each cell is an outline quad with the fill quad inset by a
+ * pixel, so a frame is one glDrawArrays call and one glFlush however many
+ * cells there are.  Positions are uploaded once; a changed cell only
+ * rewrites its colours in memory, and show() uploads the range of colours
+ * that changed since the last frame.
+ *
+ * Only needs a current GL 1.5 context, so it works the same in a GLUT
+ * window and in an offscreen Mesa context.
+ **********************************************************************/
+class BoardRenderer : public PlayfieldObserver
+{
+   int width;
+   int cells;
+   std::vector<GLfloat> positions;
+   std::vector<GLfloat> colors;
+   GLuint buffer;
+   int dirtyFirst, dirtyLast;    // cells whose colours must be uploaded
+
+public:
+   BoardRenderer(int, int, int, int);
+   BoardRenderer(Playfield *, int, int);
+   ~BoardRenderer();
+
+   void cellChanged(int, CellState);
+   void show();
+};
+#endif
@@ -1,49 +1,57 @@
 #include <iostream>
 #include "cc.h"
 
+CC::CC() : ccount(0) { }
+
 // Constructor which uses BFS to count connected components
-// Could also use dfs for this purpose
-CC::CC(SnakeGraph *G) : ccount(0)
+CC::CC(const SnakeGraph *G) : ccount(0)
+{
+   analyze(G);
+}
+
+// Find the connected components of G, forgetting any earlier graph.
+// depthFirst searches each component with dfs instead of bfs.
+void CC::analyze(const SnakeGraph *G, bool depthFirst)
 {
+   walk.reset(G->cells());
+   cc.assign(G->cells(), -1);
+   ccount = 0;
+
    for (int v : G->Vertices())
-      if (!marked[v])
+      if (!walk.marked[v])
       {
-         bfs(G, v);
+         if (depthFirst)
+            dfs(G, v);
+         else
+            bfs(G, v);
          ccount++;
       }
 }
 
 // Perform a breadth-first-search on the graph and identify
 // Nodes in the same connected component
-void CC::bfs(SnakeGraph *G, int s)
+void CC::bfs(const SnakeGraph *G, int s)
 {
-   queue<int> q;
-   q.push(s);
-   marked[s] = true;
-   while (!q.empty())
-   {
-      int v = q.front() ; q.pop();
-      cc[s] = ccount;
-      for (int w : G->adj(v))
-      {
-         if (!marked[w])
-         {
-            q.push(w);
-            marked[w] = true;
-         }
-      }
-   }
+   gridBfs(*G, s, walk, [this](int v) { cc[v] = ccount; });
+}
+
+// Perform a depth-first-search on the graph and identify
+// Nodes in the same connected component
+void CC::dfs(const SnakeGraph *G, int s)
+{
+   gridDfs(*G, s, walk, [this](int v) { cc[v] = ccount; });
 }
   
 // Return whether or not two nodes are in the same
 // connected component 
 bool CC::connected(int v, int w)
 {
-   return cc[v] == cc[w];
+   return cc[v] >= 0 && cc[v] == cc[w];
 }
 
 // Return the number of connected components found
 int CC::count() { return ccount; }
 
-// Return which connected component a vertex is in
+// Return which connected component a vertex is in, or -1 if it is not
+// a vertex
 int CC::id(int v) { return cc[v] ; }
@@ -1,5 +1,6 @@
-#include <queue>
+#include <vector>
 #include "snakeGraph.h"
+#include "graphSearch.h"
 
 /***************************************************************************//**
  * @brief Calculate the connected components in a graph
@@ -13,18 +14,27 @@
  *
  * A connected component is a maximal set of connected vertices.
  * This is a client class of the Graph API we've talked about in class
+ *
+ * The search is gridBfs from graphSearch.h, or gridDfs if analyze() is
+ * asked for a depth-first search; both find the same components.  Their
+ * tables are indexed by vertex and kept between calls, so an object
+ * reused with analyze() does not allocate once it has grown to the
+ * largest graph.
  ******************************************************************************/
 class CC
 {
-   map<int, bool> marked;
-   map<int, int> cc;
+   GridWalk walk;
+   vector<int> cc;
    int ccount;
 
 public:
-   CC(SnakeGraph *G);
+   CC();
+   CC(const SnakeGraph *G);
 
+   void analyze(const SnakeGraph *G, bool depthFirst = false);
    bool connected(int v, int w);
    int count();
    int id(int v);
-   void bfs(SnakeGraph *, int);
+   void bfs(const SnakeGraph *, int);
+   void dfs(const SnakeGraph *, int);
 };
@@ -0,0 +1,128 @@
+/***************************************************************************//**
+ * @file cellWeights.cpp
+ *
+ * @brief functions for the CellWeights implementation
+ *
+ * @par Class
+ *    CSC315 Data Structures
+ ******************************************************************************/
+
+#include "cellWeights.h"
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+//weight of the outermost ring; the centre always weighs 1
+#define BORDER_WEIGHT 64
+
+/*************************************************************************//**
+ * @brief Constructor for class CellWeights
+ *
+ * @par Description
+ *   A cell's ring is its distance to the nearest wall. With R the ring of
+ *   the centre, ring r weighs BORDER_WEIGHT * ((R + 1 - r) / (R + 1))^2,
+ *   and never less than 1. On the 17x15 board this gives the squares
+ *   64, 49, 36, ..., 1 from the wall inwards.
+ *
+ * @param[in] w - width of the playfield
+ * @param[in] h - height of the playfield
+ *
+ * @returns an instance of class CellWeights
+ ****************************************************************************/
+CellWeights::CellWeights(int w, int h) : width(w), height(h),
+  weights(w * h)
+{
+  int centre = (std::min(w, h) - 1) / 2;
+  int scale = (centre + 1) * (centre + 1);
+
+  for (int row = 0 ; row < h ; row++)
+    for (int col = 0 ; col < w ; col++)
+    {
+      int ring = std::min(std::min(row, h - 1 - row),
+                          std::min(col, w - 1 - col));
+      int k = centre + 1 - ring;
+      weights[row * w + col] = std::max(1, BORDER_WEIGHT * k * k / scale);
+    }
+
+  minWeight = weights.empty() ? 1 :
+    *std::min_element(weights.begin(), weights.end());
+}
+
+/*************************************************************************//**
+ * @brief gets the weight of a cell
+ *
+ * @param[in] cell - the index of the cell
+ *
+ * @returns the cost of entering the cell
+ ****************************************************************************/
+int CellWeights::at(int cell) const { return weights[cell]; }
+
+/*************************************************************************//**
+ * @brief gets the weight of a cell
+ *
+ * @param[in] row - the row of the cell
+ * @param[in] col - the column of the cell
+ *
+ * @returns the cost of entering the cell
+ ****************************************************************************/
+int CellWeights::at(int row, int col) const
+{
+  return weights[row * width + col];
+}
+
+/*************************************************************************//**
+ * @brief gets the table as a row-major array
+ *
+ * @returns a pointer to the first weight
+ ****************************************************************************/
+const int *CellWeights::data() const { return weights.data(); }
+
+/*************************************************************************//**
+ * @brief gets the smallest weight in the table
+ *
+ * @returns the smallest cell weight
+ ****************************************************************************/
+int CellWeights::min() const { return minWeight; }
+
+/*************************************************************************//**
+ * @brief gets the width of the table
+ *
+ * @returns width - number of columns
+ ****************************************************************************/
+int CellWeights::Width() const { return width; }
+
+/*************************************************************************//**
+ * @brief gets the height of the table
+ *
+ * @returns height - number of rows
+ ****************************************************************************/
+int CellWeights::Height() const { return height; }
+
+/*************************************************************************//**
+ * @brief gets the shared table for a board size
+ *
+ * @par Description
+ *   Tables are built the first time a size is asked for and kept for the
+ *   life of the program, so the reference stays valid. The cache is
+ *   guarded so games on different threads can share it; the lock makes
+ *   each call costly, so planners keep the table they were given and only
+ *   ask again when the board size changes.
+ *
+ * @param[in] w - width of the playfield
+ * @param[in] h - height of the playfield
+ *
+ * @returns the weight table for the size
+ ****************************************************************************/
+const CellWeights &CellWeights::forSize(int w, int h)
+{
+  static std::mutex lock;
+  static std::map<std::pair<int, int>, std::unique_ptr<CellWeights>> tables;
+
+  std::lock_guard<std::mutex> guard(lock);
+  std::unique_ptr<CellWeights> &table = tables[std::make_pair(w, h)];
+  if (!table)
+    table.reset(new CellWeights(w, h));
+  return *table;
+}
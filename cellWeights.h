@@ -0,0 +1,39 @@
+/***************************************************************************//**
+ * @file cellWeights.h
+ *
+ * @brief header file for the table of cell weights
+ *
+ * @par Class
+ *    CSC315 Data Structures
+ ******************************************************************************/
+
+#ifndef CELLWEIGHTS_H
+#define CELLWEIGHTS_H
+
+#include <vector>
+
+/*!
+* @brief the cost of entering each cell of a playfield. Cells get cheaper
+*        ring by ring towards the centre so the planners keep the snake
+*        away from the walls. Tables are generated for any size and shared
+*        between all graphs of that size.
+*/
+class CellWeights
+{
+   int width, height;
+   int minWeight;
+   std::vector<int> weights;
+public:
+   CellWeights(int, int);
+
+   int at(int) const;
+   int at(int, int) const;
+   const int *data() const;
+   int min() const;
+   int Width() const;
+   int Height() const;
+
+   static const CellWeights &forSize(int, int);
+};
+
+#endif
@@ -16,73 +16,53 @@
 #include "dijkstra.h"
 
 
+/*************************************************************************//**
+ * @brief Default constructor for class DijkstraSP
+ *
+ * @par Description
+ *   Creates an empty search object. Call search to run the algorithm.
+ *
+ * @returns an instance of class DijkstraSP
+ ****************************************************************************/
+DijkstraSP::DijkstraSP() : S(0), expandedCount(0) {}
+
+
 /*************************************************************************//**
  * @brief Constructor for class DijkstraSP
  *
  * @param[in] G - a weighted graph
  * @param[in] s - the starting point of the graph
+ * @param[in] target - vertex at which the search may stop, or NO_TARGET
  *
  * @returns an instance of class DijkstraSP
  ****************************************************************************/
-DijkstraSP::DijkstraSP(WeightedGraph *G, int s) : S(s)
+DijkstraSP::DijkstraSP(const WeightedGraph *G, int s, int target) : S(s),
+  expandedCount(0)
 {
-	//gets the set of vertices 
-  set<int> vertexList = G->Vertices();
-
-  //set all distances to infinity
-  for(int vertex : vertexList)
-    dist[vertex] = std::numeric_limits<double>::max();
-
-  //check for no negative weights
-  for(Edge e : G->Edges())
-  {
-    if(e.Weight() < 0)
-    {
-      cout << "Negative Weight detected" << endl;
-      return;
-    }
-  }
-
-  dist[S] = 0.0;
-  heap.push(make_pair(0, S));
-
-  while (!heap.empty())
-  {
-    hPair v = heap.top();
-    heap.pop();
-
-    for (Edge e : G->adj(v.second))
-      relax(v.second, e);
-  }
+  search(G, s, target);
 }
 
 
 /*************************************************************************//**
- * @brief relaxes the distance between two nodes
+ * @brief runs dijkstra's algorithm from a source vertex
  *
  * @par Description
- *   The function relaxes the distance between two nodes by finding the 
- *   shortest distance between nodes
+ *   The tables are sized to the number of cells in the grid and reused
+ *   between calls. The search itself is gridDijkstra from graphSearch.h,
+ *   run over the graph's arrays. If a target is given the search stops as
+ *   soon as the target is removed from the queue; at that point the
+ *   distance and path to the target (and to every vertex settled before
+ *   it) are final.
  *
- * @param[in] v - the vertex
- * @param[in] e - the edge between the starting node and the vertex
+ * @param[in] G - a weighted graph
+ * @param[in] s - the starting point of the graph
+ * @param[in] target - vertex at which the search may stop, or NO_TARGET
  *
  * @returns none
  ****************************************************************************/
-void DijkstraSP::relax(int v, Edge e)
+void DijkstraSP::search(const WeightedGraph *G, int s, int target)
 {
-  int w = e.other(v);
-
-  //relax if the distance is shorter
-  if (dist[w] > dist[v] + e.Weight())
-  {
-	  //set the new distance
-    dist[w] = dist[v] + e.Weight();
-    //set the previous vertex to the vurrent
-    prev[w] = v;
-    //push the pair on the heap
-    heap.push(make_pair(dist[w], w));
-  }
+  searchGrid(*G, s, target);
 }
 
 
@@ -98,12 +78,12 @@ void DijkstraSP::relax(int v, Edge e)
  * @returns true - if there is a path
  * 	    false - if there is no path
  ****************************************************************************/
-bool DijkstraSP::hasPathTo(int v)
+bool DijkstraSP::hasPathTo(int v) const
 {
-  if(dist.count(v)!=0)
-    return dist[v] != std::numeric_limits<double>::max();
-  else
+  if (v < 0 || v >= (int)dist.size())
     return false;
+
+  return dist[v] != INFINITE_DISTANCE;
 }
 
 
@@ -118,7 +98,7 @@ bool DijkstraSP::hasPathTo(int v)
  *
  * @returns path - the path from the starting node to the destination
  ****************************************************************************/
-stack<int> DijkstraSP::pathTo(int v)
+stack<int> DijkstraSP::pathTo(int v) const
 {
   stack<int> path;
 
@@ -135,10 +115,24 @@ stack<int> DijkstraSP::pathTo(int v)
  *
  * @par Description
  *   The function gets the distance of the vertex from the starting vertex by
- *   simple map look up
+ *   simple table look up
  *
  * @param[in] v - the destination vertex
  *
  * @returns dist - the distance between the nodes
  ****************************************************************************/
-double DijkstraSP::distance(int v) { return dist[v] ; }
+int DijkstraSP::distance(int v) const
+{
+  if (v < 0 || v >= (int)dist.size())
+    return INFINITE_DISTANCE;
+
+  return dist[v];
+}
+
+
+/*************************************************************************//**
+ * @brief gets the number of vertices taken from the queue by the last search
+ *
+ * @returns expandedCount - number of expanded vertices
+ ****************************************************************************/
+int DijkstraSP::expanded() const { return expandedCount; }
@@ -16,31 +16,63 @@
 #ifndef DIJKSTRA_H
 #define DIJKSTRA_H
 
-#include <map>
-#include <limits>
+#include <iostream>
 #include <stack>
-#include <queue>
+#include <vector>
 #include "weightedGraph.h"
-
-//typedefing a pair of int and int to hPair
-typedef pair<int, int> hPair;
+#include "indexMinPQ.h"
+#include "graphSearch.h"
 
 /*!
-* @brief contains data for performing dijkstra's algorithm on a graph
+* @brief contains data for performing dijkstra's algorithm on a graph. The
+*        distance and previous-vertex tables are dense vectors indexed by
+*        cell, and one object can be reused for many searches without
+*        reallocating.
 */
 class DijkstraSP
 {
-   map<int, int> prev;
-   map<int, double> dist;
-   priority_queue<hPair, std::vector<hPair>, greater<hPair>> heap;
+   vector<int> prev;
+   vector<int> dist;
+   IndexMinPQ pq;
    int S;
+   int expandedCount;
 public:
-   DijkstraSP(WeightedGraph *, int);
+   DijkstraSP();
+   DijkstraSP(const WeightedGraph *, int, int target = NO_TARGET);
 
-   void relax(int, Edge);
-   double distance(int);
-   bool hasPathTo(int);
-   stack<int> pathTo(int);
+   void search(const WeightedGraph *, int, int target = NO_TARGET);
+   template <class G> void searchGrid(const G &, int, int target = NO_TARGET);
+   int distance(int) const;
+   bool hasPathTo(int) const;
+   stack<int> pathTo(int) const;
+   int expanded() const;
 };
 
+
+/*************************************************************************//**
+ * @brief runs dijkstra's algorithm over any grid graph
+ *
+ * @par Description
+ *   Runs gridDijkstra from graphSearch.h on a type that models the grid
+ *   graph concept, such as an ImplicitGrid over the playfield, so no graph
+ *   has to be built first. The tables are reused as by the other search.
+ *
+ * @param[in] g - a grid graph
+ * @param[in] s - the starting point of the graph
+ * @param[in] target - vertex at which the search may stop, or NO_TARGET
+ *
+ * @returns none
+ ****************************************************************************/
+template <class G>
+void DijkstraSP::searchGrid(const G &g, int s, int target)
+{
+  S = s;
+  expandedCount = gridDijkstra(g, s, target, dist, prev, pq);
+  if (expandedCount < 0)
+  {
+    cout << "Negative Weight detected" << endl;
+    expandedCount = 0;
+  }
+}
+
 #endif
@@ -1,29 +1,60 @@
 #include <iostream>
 #include <chrono>
 #include <vector>
+#include <cstring>
+#include <ctime>
+#include <unistd.h>
 #include "game.h"
 #include "player.h"
 
 using namespace std;
 using namespace std::chrono;
 
-int main()
+// Usage: driver [dijkstra|astar|dstar|survival|hamilton] [width height [log]]
+// The optional first argument selects A*, the incremental D* Lite planner,
+// the survival planner or the Hamiltonian cycle instead of Dijkstra for
+// path planning.  The board is 17x15 unless a size is given.  If a log
+// file is named, a telemetry record of every move is written to it.
+int main(int argc, char *argv[])
 {
    vector<duration<double>> turnTimes;
-   time_point<system_clock> start, end;
+   steady_clock::time_point start, end;
 
-   Player *player = new Player();
+   SearchMode mode = DIJKSTRA;
+   if (argc > 1 && strcmp(argv[1], "astar") == 0) mode = ASTAR;
+   if (argc > 1 && strcmp(argv[1], "dstar") == 0) mode = DSTAR_LITE;
+   if (argc > 1 && strcmp(argv[1], "survival") == 0) mode = SURVIVAL;
+   if (argc > 1 && strcmp(argv[1], "hamilton") == 0) mode = HAMILTON;
+
+   int width = PLAYFIELD_WIDTH;
+   int height = PLAYFIELD_HEIGHT;
+   if (argc > 3)
+   {
+      width = atoi(argv[2]);
+      height = atoi(argv[3]);
+   }
+
+   Player *player = new Player(mode);
    // Passing the Playfield constructor a true value will include objstacles
    // In the Playfield.  Eg.
-   // Playfield *playfield = new Playfield(true);
-   Playfield *playfield = new Playfield();
+   // Playfield *playfield = new Playfield(width, height, true, seed);
+   Playfield *playfield = new Playfield(width, height, false,
+                                        time(NULL) ^ getpid());
    Game *game = new Game(player, playfield);
 
+   TelemetryLog *log = NULL;
+   if (argc > 4)
+   {
+      log = new TelemetryLog(argv[4], width, height);
+      if (!log->good()) cerr << "Cannot write " << argv[4] << endl;
+      game->setTelemetry(log);
+   }
+
    while (!game->isGameOver())
    {
-      start = system_clock::now();
+      start = steady_clock::now();
       game->makeMove();
-      end = system_clock::now();
+      end = steady_clock::now();
       turnTimes.push_back(end-start);
    }
    cout << "Final Score: " << game->getScore() << endl;
@@ -33,5 +64,13 @@ int main()
       sum += d.count();
 
    cout << "Average turn time: " << sum/turnTimes.size() << endl;
+
+   if (player->getSearches() > 0)
+      cout << "Average nodes expanded: "
+           << (double)player->getNodesExpanded() / player->getSearches() << endl;
+   delete game;
+   if (log && log->droppedCount() > 0)
+      cout << "Telemetry records dropped: " << log->droppedCount() << endl;
+   delete log;
    return 0;
 }
@@ -0,0 +1,373 @@
+/***************************************************************************//**
+ * @file dstarLite.cpp
+ *
+ * @brief functions for the DStarLite implementation
+ *
+ * @par Description
+ *   Follows the optimized D* Lite of Koenig and Likhachev. g is the current
+ *   distance estimate to the goal and rhs is the one step lookahead
+ *   min(cost(s, s') + g(s')) over the successors of s. A vertex is in the
+ *   queue exactly when g and rhs differ.
+ *
+ * @par Class
+ *    CSC315 Data Structures
+ ******************************************************************************/
+
+#include "dstarLite.h"
+#include <cstdlib>
+
+//adds two distances without overflowing past infinity
+static int addDistance(int a, int b)
+{
+  if (a == INFINITE_DISTANCE || b == INFINITE_DISTANCE)
+    return INFINITE_DISTANCE;
+  return a + b;
+}
+
+/*************************************************************************//**
+ * @brief Constructor for class DStarLite
+ *
+ * @par Description
+ *   Creates an empty planner. Call reset before using it.
+ *
+ * @returns an instance of class DStarLite
+ ****************************************************************************/
+DStarLite::DStarLite() : width(0), height(0), start(-1), goal(-1), last(-1),
+  km(0), minWeight(0), expandedCount(0), weights(nullptr) {}
+
+/*************************************************************************//**
+ * @brief starts a new search on a grid
+ *
+ * @par Description
+ *   Copies which cells are blocked out of the grid and seeds the queue with
+ *   the goal. Nothing is expanded until computeShortestPath is called. This
+ *   is needed whenever the goal moves; any other change to the board should
+ *   be passed to updateCell instead.
+ *
+ * @param[in] grid - the playfield
+ * @param[in] w - width of the playfield
+ * @param[in] h - height of the playfield
+ * @param[in] s - the start cell
+ * @param[in] t - the goal cell
+ *
+ * @returns none
+ ****************************************************************************/
+void DStarLite::reset(const GridCell *grid, int w, int h, int s, int t)
+{
+  int cells = w * h;
+
+  width = w;
+  height = h;
+  start = last = s;
+  goal = t;
+  km = 0;
+
+  // the shared table is only looked up again when the size changes
+  if (!weights || weights->Width() != w || weights->Height() != h)
+  {
+    weights = &CellWeights::forSize(w, h);
+    minWeight = weights->min();
+  }
+
+  blocked.resize(cells);
+  for (int i = 0 ; i < cells ; i++)
+    blocked[i] = (grid[i] == TAIL_VALUE);
+
+  g.assign(cells, INFINITE_DISTANCE);
+  rhs.assign(cells, INFINITE_DISTANCE);
+  pq.reset(cells);
+
+  rhs[goal] = 0;
+  pq.insert(goal, calculateKey(goal));
+}
+
+/*************************************************************************//**
+ * @brief moves the start of the search to a new cell
+ *
+ * @par Description
+ *   The key modifier grows by the heuristic distance the start moved so the
+ *   keys already in the queue remain lower bounds.
+ *
+ * @param[in] s - the new start cell
+ *
+ * @returns none
+ ****************************************************************************/
+void DStarLite::moveStart(int s)
+{
+  km += heuristic(last, s);
+  last = start = s;
+}
+
+/*************************************************************************//**
+ * @brief records that a cell became blocked or open
+ *
+ * @par Description
+ *   Changing a cell changes the cost of every edge into and out of it, so
+ *   the lookahead of the cell and of its neighbours is recomputed.
+ *
+ * @param[in] v - the cell
+ * @param[in] isBlocked - whether the cell can no longer be entered
+ *
+ * @returns none
+ ****************************************************************************/
+void DStarLite::updateCell(int v, bool isBlocked)
+{
+  if (v < 0 || v >= width * height || blocked[v] == isBlocked) return;
+
+  blocked[v] = isBlocked;
+
+  int adj[4];
+  int count = neighbors(v, adj);
+
+  if (v != goal) rhs[v] = computeRhs(v);
+  updateVertex(v);
+  for (int i = 0 ; i < count ; i++)
+  {
+    if (adj[i] != goal) rhs[adj[i]] = computeRhs(adj[i]);
+    updateVertex(adj[i]);
+  }
+}
+
+/*************************************************************************//**
+ * @brief expands vertices until the distance from the start is known
+ *
+ * @returns none
+ ****************************************************************************/
+void DStarLite::computeShortestPath()
+{
+  expandedCount = 0;
+  if (start < 0) return;
+
+  while (!pq.isEmpty() &&
+         (pq.minKey() < calculateKey(start) || rhs[start] > g[start]))
+  {
+    int u = pq.minIndex();
+    pqKey_t kOld = pq.minKey();
+    pqKey_t kNew = calculateKey(u);
+    int adj[4];
+    int count = neighbors(u, adj);
+
+    expandedCount++;
+    if (kOld < kNew)
+    {
+      pq.changeKey(u, kNew);
+    }
+    else if (g[u] > rhs[u])
+    {
+      //locally overconsistent: the new distance is final
+      g[u] = rhs[u];
+      pq.remove(u);
+      for (int i = 0 ; i < count ; i++)
+      {
+        int s = adj[i];
+        if (s != goal)
+        {
+          int through = addDistance(cost(s, u), g[u]);
+          if (through < rhs[s]) rhs[s] = through;
+        }
+        updateVertex(s);
+      }
+    }
+    else
+    {
+      //locally underconsistent: raise u and repair whoever relied on it
+      int gOld = g[u];
+      g[u] = INFINITE_DISTANCE;
+      for (int i = 0 ; i < count ; i++)
+      {
+        int s = adj[i];
+        if (s != goal && rhs[s] == addDistance(cost(s, u), gOld))
+          rhs[s] = computeRhs(s);
+        updateVertex(s);
+      }
+      if (u != goal) rhs[u] = computeRhs(u);
+      updateVertex(u);
+    }
+  }
+}
+
+/*************************************************************************//**
+ * @brief gets the cell the start should move to next
+ *
+ * @returns the neighbour of the start on a shortest path, or -1 if the goal
+ *          cannot be reached
+ ****************************************************************************/
+int DStarLite::nextStep() const
+{
+  if (start < 0) return -1;
+
+  int adj[4];
+  int count = neighbors(start, adj);
+  int best = -1;
+  int bestDist = INFINITE_DISTANCE;
+
+  for (int i = 0 ; i < count ; i++)
+  {
+    int d = addDistance(cost(start, adj[i]), g[adj[i]]);
+    if (d < bestDist)
+    {
+      bestDist = d;
+      best = adj[i];
+    }
+  }
+  return best;
+}
+
+/*************************************************************************//**
+ * @brief the path from the start to the goal
+ *
+ * @par Description
+ *   Follows the cheapest neighbour from the start until the goal is reached.
+ *   The stack has the first cell to move to on top and is empty if there is
+ *   no path.
+ *
+ * @returns the path from the start to the goal
+ ****************************************************************************/
+stack<int> DStarLite::path() const
+{
+  vector<int> cells;
+  stack<int> path;
+  int v = start;
+
+  while (v != goal)
+  {
+    int adj[4];
+    int count = neighbors(v, adj);
+    int best = -1;
+    int bestDist = INFINITE_DISTANCE;
+
+    for (int i = 0 ; i < count ; i++)
+    {
+      int d = addDistance(cost(v, adj[i]), g[adj[i]]);
+      if (d < bestDist)
+      {
+        bestDist = d;
+        best = adj[i];
+      }
+    }
+    if (best < 0 || (int)cells.size() >= width * height) return path;
+    cells.push_back(best);
+    v = best;
+  }
+
+  for (int i = cells.size() - 1 ; i >= 0 ; i--)
+    path.push(cells[i]);
+  return path;
+}
+
+/*************************************************************************//**
+ * @brief checks whether the planner considers a cell blocked
+ *
+ * @param[in] v - the cell
+ *
+ * @returns true if the cell cannot be entered
+ ****************************************************************************/
+bool DStarLite::isBlocked(int v) const { return blocked[v] != 0; }
+
+/*************************************************************************//**
+ * @brief gets the start cell
+ *
+ * @returns start - the start cell, -1 before the first reset
+ ****************************************************************************/
+int DStarLite::getStart() const { return start; }
+
+/*************************************************************************//**
+ * @brief gets the goal cell
+ *
+ * @returns goal - the goal cell, -1 before the first reset
+ ****************************************************************************/
+int DStarLite::getGoal() const { return goal; }
+
+/*************************************************************************//**
+ * @brief gets the width of the grid being searched
+ *
+ * @returns width - number of columns
+ ****************************************************************************/
+int DStarLite::getWidth() const { return width; }
+
+/*************************************************************************//**
+ * @brief gets the height of the grid being searched
+ *
+ * @returns height - number of rows
+ ****************************************************************************/
+int DStarLite::getHeight() const { return height; }
+
+/*************************************************************************//**
+ * @brief gets the number of vertices taken from the queue by the last call
+ *        to computeShortestPath
+ *
+ * @returns expandedCount - number of expanded vertices
+ ****************************************************************************/
+int DStarLite::expanded() const { return expandedCount; }
+
+//Fills adj with the in-bounds 4-neighbours of v and returns how many there are
+int DStarLite::neighbors(int v, int *adj) const
+{
+  int row = v / width;
+  int col = v % width;
+  int count = 0;
+
+  if (row > 0) adj[count++] = v - width;
+  if (row < height - 1) adj[count++] = v + width;
+  if (col > 0) adj[count++] = v - 1;
+  if (col < width - 1) adj[count++] = v + 1;
+  return count;
+}
+
+//Cost of moving from u to its neighbour v
+int DStarLite::cost(int u, int v) const
+{
+  if (blocked[u] || blocked[v]) return INFINITE_DISTANCE;
+  return weights->at(v);
+}
+
+//Manhattan distance between two cells scaled by the cheapest cell weight
+int DStarLite::heuristic(int u, int v) const
+{
+  int dx = abs(u % width - v % width);
+  int dy = abs(u / width - v / width);
+
+  return minWeight * (dx + dy);
+}
+
+//Priority of a vertex: [min(g, rhs) + h + km ; min(g, rhs)] packed into one
+//key so the queue compares them lexicographically
+pqKey_t DStarLite::calculateKey(int v) const
+{
+  int m = (g[v] < rhs[v]) ? g[v] : rhs[v];
+  pqKey_t k1 = addDistance(addDistance(m, heuristic(start, v)), km);
+  pqKey_t k2 = m;
+
+  return (k1 << 32) | k2;
+}
+
+//One step lookahead: cheapest cost through any successor of v
+int DStarLite::computeRhs(int v) const
+{
+  int adj[4];
+  int count = neighbors(v, adj);
+  int best = INFINITE_DISTANCE;
+
+  for (int i = 0 ; i < count ; i++)
+  {
+    int d = addDistance(cost(v, adj[i]), g[adj[i]]);
+    if (d < best) best = d;
+  }
+  return best;
+}
+
+//Puts v in the queue if it is inconsistent and takes it out otherwise
+void DStarLite::updateVertex(int v)
+{
+  if (g[v] != rhs[v])
+  {
+    if (pq.contains(v))
+      pq.changeKey(v, calculateKey(v));
+    else
+      pq.insert(v, calculateKey(v));
+  }
+  else if (pq.contains(v))
+  {
+    pq.remove(v);
+  }
+}
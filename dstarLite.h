@@ -0,0 +1,64 @@
+/***************************************************************************//**
+ * @file dstarLite.h
+ *
+ * @brief header file for the incremental D* Lite planner
+ *
+ * @par Class
+ *    CSC315 Data Structures
+ ******************************************************************************/
+
+#ifndef DSTARLITE_H
+#define DSTARLITE_H
+
+#include <stack>
+#include <vector>
+#include "weightedGraph.h"
+#include "cellWeights.h"
+#include "indexMinPQ.h"
+#include "dijkstra.h"
+
+/*!
+* @brief contains the search state of a D* Lite planner on the playfield
+*        grid. The search runs backwards from the goal, so when the start
+*        moves and a few cells change only the vertices whose distance is
+*        affected are expanded again. The cost of entering an open cell is
+*        its CellWeights entry; blocked cells cannot be entered.
+*/
+class DStarLite
+{
+   int width, height;
+   int start, goal, last;
+   int km;
+   int minWeight;
+   int expandedCount;
+   const CellWeights *weights;
+   vector<char> blocked;
+   vector<int> g;
+   vector<int> rhs;
+   IndexMinPQ pq;
+public:
+   DStarLite();
+
+   void reset(const GridCell *, int, int, int, int);
+   void moveStart(int);
+   void updateCell(int, bool);
+   void computeShortestPath();
+   int nextStep() const;
+   stack<int> path() const;
+   bool isBlocked(int) const;
+   int getStart() const;
+   int getGoal() const;
+   int getWidth() const;
+   int getHeight() const;
+   int expanded() const;
+
+private:
+   int neighbors(int, int *) const;
+   int cost(int, int) const;
+   int heuristic(int, int) const;
+   pqKey_t calculateKey(int) const;
+   int computeRhs(int) const;
+   void updateVertex(int);
+};
+
+#endif
@@ -28,7 +28,7 @@
  * @returns Edge - an instance of class Edge 
  ****************************************************************************/
 
-Edge::Edge(int s, int e, double w) : v(s), w(e), weight(w){}
+Edge::Edge(int s, int e, int w) : v(s), w(e), weight(w){}
 
 /*************************************************************************//**
  * @brief gets either of the vertices of the edge
@@ -118,7 +118,7 @@ std::ostream &operator <<(std::ostream &os, const Edge &e)
  * @returns weight - the weight of the edge
  ****************************************************************************/
 
-double Edge::Weight() const
+int Edge::Weight() const
 {
   return weight;
 }
@@ -27,15 +27,15 @@ class Edge
 {
    int v;
    int w;
-   double weight;
+   int weight;
 public:
-   Edge(int, int, double);
+   Edge(int, int, int);
 
    int either() const;
    int other(int) const;
    bool operator<(const Edge &) const;
    friend std::ostream &operator <<(std::ostream &, const Edge&);
-   double Weight() const;
+   int Weight() const;
 };
 
 #endif
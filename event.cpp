@@ -1,30 +1,75 @@
 #include "event.h"
 
-KeyboardEvent::KeyboardEvent(unsigned char k, int x, int y) : key(k), x(x), y(y) {}
+Event Event::display()
+{
+   Event e;
+   e.type = DISPLAY_EVENT;
+   return e;
+}
 
-void KeyboardEvent::doAction(Game *game)
+Event Event::resize(int w, int h)
 {
-   if (key == ESCAPE_KEY)
-   {
-      delete game;
+   Event e;
+   e.type = RESHAPE_EVENT;
+   e.reshape.w = w;
+   e.reshape.h = h;
+   return e;
+}
+
+Event Event::tick()
+{
+   Event e;
+   e.type = TICKTOCK_EVENT;
+   return e;
+}
+
+Event Event::key(unsigned char k, int x, int y)
+{
+   Event e;
+   e.type = KEYBOARD_EVENT;
+   e.keyboard.key = k;
+   e.keyboard.x = x;
+   e.keyboard.y = y;
+   return e;
+}
+
+static void keyboardAction(const Event &event)
+{
+   if (event.keyboard.key == ESCAPE_KEY)
       glutLeaveMainLoop();
-   }
 }
 
-void DisplayEvent::doAction(Game *game)
+void doAction(const Event &event, Simulation *sim, BoardRenderer *renderer)
 {
-   if (game->isGameOver())
+   switch (event.type)
    {
-      glutLeaveMainLoop();
+      // Draw the newest board the game has published, including the crash
+      // of a game that has just ended
+      case DISPLAY_EVENT: sim->show(renderer); break;
+      case RESHAPE_EVENT: break;
+      // The game plays on its own thread; a tick only asks for a frame
+      case TICKTOCK_EVENT: glutPostRedisplay(); break;
+      case KEYBOARD_EVENT: keyboardAction(event); break;
    }
-   else
-      game->draw();
 }
 
-ReshapeEvent::ReshapeEvent(int w, int h) : w(w), h(h){}
+EventQueue::EventQueue() : first(0), count(0) {}
+
+// Add an event, or return false if the queue is full
+bool EventQueue::push(const Event &event)
+{
+   if (count == EVENT_QUEUE_SIZE) return false;
+   events[(first + count) % EVENT_QUEUE_SIZE] = event;
+   count++;
+   return true;
+}
 
-void TickTockEvent::doAction(Game *game)
+// Take the oldest event, or return false if there is none
+bool EventQueue::pop(Event &event)
 {
-   game->makeMove();
-   glutPostRedisplay();
+   if (count == 0) return false;
+   event = events[first];
+   first = (first + 1) % EVENT_QUEUE_SIZE;
+   count--;
+   return true;
 }
@@ -1,45 +1,52 @@
 #ifndef __EVENT_H
 #define __EVENT_H
 #include <iostream>
-#include "player.h"
-#include "game.h"
+#include <GL/freeglut.h>
+#include "simulation.h"
+#include "boardRenderer.h"
 
 #define ESCAPE_KEY 27
 
-class Event
-{
-public:
-   void virtual doAction(Game *) = 0;
-   virtual ~Event(){};
-};
+// Events the queue holds before new ones are dropped
+#define EVENT_QUEUE_SIZE 64
 
-class DisplayEvent : public Event
-{
-public:
-   void doAction(Game *);
-};
+enum EventType {DISPLAY_EVENT, RESHAPE_EVENT, TICKTOCK_EVENT, KEYBOARD_EVENT};
 
-class ReshapeEvent : public Event
+/*!
+* @brief one GLUT callback, as a plain value. The type says which member of
+*        the union holds its data, so events are copied into a queue and
+*        dispatched with a switch instead of being allocated and called
+*        through a virtual function.
+*/
+struct Event
 {
-   int w, h;
-public:
-   ReshapeEvent(int, int);
-   void doAction(Game *) {}
-};
+   EventType type;
+   union
+   {
+      struct { int w, h; } reshape;
+      struct { unsigned char key; int x, y; } keyboard;
+   };
 
-class TickTockEvent : public Event
-{
-public:
-   void doAction(Game *);
+   static Event display();
+   static Event resize(int, int);
+   static Event tick();
+   static Event key(unsigned char, int, int);
 };
 
-class KeyboardEvent : public Event
+void doAction(const Event &, Simulation *, BoardRenderer *);
+
+/*!
+* @brief a fixed ring of events, allocated once
+*/
+class EventQueue
 {
-   unsigned char key;
-   int x, y;
+   Event events[EVENT_QUEUE_SIZE];
+   int first;
+   int count;
 public:
-   KeyboardEvent(unsigned char, int, int);
-   void doAction(Game *);
+   EventQueue();
+   bool push(const Event &);
+   bool pop(Event &);
 };
 
 #endif
@@ -1,6 +1,14 @@
 #include "game.h"
+#include "profile.h"
 
-Game::Game(Player *p, Playfield *pf) : player(p), playfield(pf), gameOver(false), score(0)
+Game::Game(Strategy *p, Playfield *pf) : player(p), playfield(pf), gameOver(false), score(0),
+   telemetry(NULL), replay(NULL), tick(0)
+{ }
+
+// Build the game's own playfield of the given size
+Game::Game(Strategy *p, int width, int height, bool obstacles, uint64_t seed,
+           double density)
+   : Game(p, new Playfield(width, height, obstacles, seed, density))
 { }
 
 Game::~Game()
@@ -12,21 +20,56 @@ Game::~Game()
 bool Game::makeMove()
 {
    bool retVal = false;
+   std::chrono::steady_clock::time_point start;
+   if (telemetry) start = std::chrono::steady_clock::now();
    
-   ValidMove playerMove = player->makeMove(playfield);
+   ValidMove playerMove = player->makeMove(playfield->getView());
+
+   float planMicros = 0;
+   if (telemetry)
+      planMicros = std::chrono::duration<float, std::micro>(
+         std::chrono::steady_clock::now() - start).count();
+
+   PhaseTimer timer(PHASE_MOVE);
    retVal = playfield->moveHead(playerMove);
 
    if (!retVal) gameIsOver();
 
    playfield->updatePlayfield();
+
+   if (telemetry)
+   {
+      const PlayfieldView &view = playfield->getView();
+      TickRecord record = {tick, view.head, view.food, view.length,
+                           planMicros, (uint8_t)playerMove, !gameOver, 0};
+      telemetry->publish(record);
+   }
+   if (replay)
+   {
+      replay->record(playerMove);
+      if (gameOver) replay->finish(getScore());
+   }
+   tick++;
    return !isGameOver();
 }
 
+// Publish a record of every move to log from now on, or stop if log is
+// NULL.  The game does not own the log.
+void Game::setTelemetry(TelemetryLog *log) { telemetry = log; }
+
+// Record every move from now on into recorder, which starts from the
+// current playfield.  Call this before the first move so the replay holds
+// the whole game.  The game does not own the recorder.
+void Game::setReplay(ReplayRecorder *recorder)
+{
+   replay = recorder;
+   if (replay) replay->begin(playfield);
+}
+
 void Game::gameIsOver() { gameOver = true; }
 
 bool Game::isGameOver() { return gameOver; }
 
 int Game::getScore() { return playfield->getScore() ; }
 
-void Game::draw()
-{ }
+void Game::draw() { playfield->draw(); }
@@ -2,19 +2,24 @@
 #define __GAME_H
 #include <map>
 #include <sstream>
-#include <GL/freeglut.h>
-#include "graphics.h"
 #include "player.h"
+#include "telemetry.h"
+#include "replayFile.h"
 
 class Game
 {
-   Player * player;
+   Strategy * player;
    Playfield *playfield;
    bool gameOver;
    int  score;
+   TelemetryLog *telemetry;
+   ReplayRecorder *replay;
+   uint32_t tick;
 
 public:
-   Game(Player *, Playfield *);
+   Game(Strategy *, Playfield *);
+   Game(Strategy *, int width, int height, bool obstacles, uint64_t seed,
+        double density = OBSTACLE_DENSITY);
    ~Game();
 
    bool isGameOver();
@@ -22,6 +27,8 @@ public:
    int  getScore();
    void draw();
    bool makeMove();
+   void setTelemetry(TelemetryLog *);
+   void setReplay(ReplayRecorder *);
 
 private:
 };
@@ -0,0 +1,297 @@
+/********************************************************************//**
+ * @file
+ *
+ * Graph searches over any type that models the grid graph concept of
+ * gridGraph.h: breadth-first and depth-first search, Tarjan's
+ * articulation points, Dijkstra and A*.  They are templates on the graph
+ * type so neighbour enumeration inlines into the search loop, whether the
+ * graph is stored or worked out from a grid.  Every search keeps its
+ * state in tables the caller owns and passes in again, so a search that
+ * is repeated on graphs of the same size does not allocate.
+ ***********************************************************************/
+#ifndef GRAPHSEARCH_H
+#define GRAPHSEARCH_H
+#include <limits>
+#include <vector>
+#include "gridGraph.h"
+#include "indexMinPQ.h"
+
+//distance of a vertex that has not been reached
+#define INFINITE_DISTANCE std::numeric_limits<int>::max()
+
+//target value meaning "search the whole graph"
+#define NO_TARGET -1
+
+#define NO_PARENT -1
+
+/********************************************************************//**
+ * @struct GridWalk
+ *
+ * State of a breadth-first or depth-first walk.  reset() clears the
+ * marks; walks started afterwards skip vertices an earlier one reached,
+ * which is how components are found.
+ **********************************************************************/
+struct GridWalk
+{
+   std::vector<char> marked;
+   std::vector<int> order;    // the queue or stack
+   std::vector<int> next;     // next neighbour slot, per vertex
+
+   void reset(int cells)
+   {
+      marked.assign(cells, 0);
+      order.clear();
+      order.reserve(cells);
+      next.resize(cells);
+   }
+};
+
+// Breadth-first search from s.  Calls visit(v) for every unmarked vertex
+// reached, in order of distance from s.  Every vertex is queued once, so
+// the queue is an array read from the front.
+template <class G, class Visit>
+void gridBfs(const G &g, int s, GridWalk &walk, Visit visit)
+{
+   std::vector<int> &queue = walk.order;
+
+   queue.clear();
+   queue.push_back(s);
+   walk.marked[s] = 1;
+   for (size_t front = 0 ; front < queue.size() ; front++)
+   {
+      int v = queue[front];
+      visit(v);
+      for (int k = 0 ; k < GRID_DEGREE ; k++)
+      {
+         int w = g.neighbour(v, k);
+         if (w != NO_NEIGHBOUR && !walk.marked[w])
+         {
+            walk.marked[w] = 1;
+            queue.push_back(w);
+         }
+      }
+   }
+}
+
+// Depth-first search from s.  Calls visit(v) for every unmarked vertex
+// reached, in preorder.  The stack holds the path from s and each vertex
+// on it remembers which neighbour slot to try next, so the order is the
+// one the recursive search would give.
+template <class G, class Visit>
+void gridDfs(const G &g, int s, GridWalk &walk, Visit visit)
+{
+   std::vector<int> &stack = walk.order;
+
+   stack.clear();
+   stack.push_back(s);
+   walk.marked[s] = 1;
+   walk.next[s] = 0;
+   visit(s);
+   while (!stack.empty())
+   {
+      int v = stack.back();
+      if (walk.next[v] == GRID_DEGREE)
+      {
+         stack.pop_back();
+         continue;
+      }
+      int w = g.neighbour(v, walk.next[v]++);
+      if (w != NO_NEIGHBOUR && !walk.marked[w])
+      {
+         walk.marked[w] = 1;
+         walk.next[w] = 0;
+         visit(w);
+         stack.push_back(w);
+      }
+   }
+}
+
+/********************************************************************//**
+ * @struct ArticulationTables
+ *
+ * State of Tarjan's search for articulation points, indexed by vertex.
+ * Each gridArticulation call adds one connected component.
+ **********************************************************************/
+struct ArticulationTables
+{
+   std::vector<int> time;        // visit order, -1 until visited
+   std::vector<int> loTime;      // earliest visit reachable by a back edge
+   std::vector<int> parent;
+   std::vector<int> component;   // -1 for vertices not reached
+   std::vector<int> next;        // next neighbour slot, per vertex
+   std::vector<int> stack;
+   std::vector<char> articulation;
+   std::vector<int> points;      // the articulation points found
+   int clock;
+   int components;
+
+   // assign() keeps the capacity, so reused tables do not allocate
+   void reset(int cells)
+   {
+      time.assign(cells, -1);
+      loTime.assign(cells, 0);
+      parent.assign(cells, NO_PARENT);
+      component.assign(cells, -1);
+      next.assign(cells, 0);
+      articulation.assign(cells, 0);
+      points.clear();
+      stack.clear();
+      stack.reserve(cells);
+      clock = 0;
+      components = 0;
+   }
+};
+
+// Depth-first search from root, marking its component and the
+// articulation points in it.  The recursive version's call frames are
+// replaced by a stack of vertices and, per vertex, the next neighbour
+// slot to try.  When a vertex is finished its loTime is passed up to its
+// parent, which is what returning from the recursive call did.
+template <class G>
+void gridArticulation(const G &g, int root, ArticulationTables &t)
+{
+   int rootChildren = 0;
+
+   t.time[root] = t.loTime[root] = t.clock++;
+   t.component[root] = t.components;
+   t.stack.push_back(root);
+
+   while (!t.stack.empty())
+   {
+      int v = t.stack.back();
+
+      if (t.next[v] == GRID_DEGREE)
+      {
+         // v is finished
+         t.stack.pop_back();
+         int p = t.parent[v];
+         if (p == NO_PARENT) continue;
+         if (t.loTime[v] < t.loTime[p]) t.loTime[p] = t.loTime[v];
+         if (p != root && t.time[p] <= t.loTime[v] && !t.articulation[p])
+         {
+            t.articulation[p] = 1;
+            t.points.push_back(p);
+         }
+         continue;
+      }
+
+      int w = g.neighbour(v, t.next[v]++);
+      if (w == NO_NEIGHBOUR) continue;
+      if (t.time[w] < 0)
+      {
+         // tree edge
+         t.parent[w] = v;
+         t.time[w] = t.loTime[w] = t.clock++;
+         t.component[w] = t.components;
+         t.stack.push_back(w);
+         if (v == root) rootChildren++;
+      }
+      else if (w != t.parent[v])
+      {
+         // back edge
+         if (t.time[w] < t.loTime[v]) t.loTime[v] = t.time[w];
+      }
+   }
+
+   // A root is an articulation point when it has two or more independent
+   // children
+   if (rootChildren >= 2)
+   {
+      t.articulation[root] = 1;
+      t.points.push_back(root);
+   }
+   t.components++;
+}
+
+// Dijkstra's algorithm from s.  If a target is given the search stops as
+// soon as the target is removed from the queue; at that point the
+// distance and path to the target (and to every vertex settled before
+// it) are final.  Returns the number of vertices taken from the queue,
+// or -1 if a negative cost was found.
+template <class G>
+int gridDijkstra(const G &g, int s, int target, std::vector<int> &dist,
+                 std::vector<int> &prev, IndexMinPQ &pq)
+{
+   int cells = g.cells();
+   int expanded = 0;
+
+   dist.assign(cells, INFINITE_DISTANCE);
+   prev.assign(cells, -1);
+   pq.reset(cells);
+   if (s < 0 || s >= cells) return 0;
+
+   dist[s] = 0;
+   pq.insert(s, 0);
+   while (!pq.isEmpty())
+   {
+      int v = pq.delMin();
+      expanded++;
+      if (v == target) break;
+
+      for (int k = 0 ; k < GRID_DEGREE ; k++)
+      {
+         int w = g.neighbour(v, k);
+         if (w == NO_NEIGHBOUR) continue;
+         int cost = g.cost(w);
+         if (cost < 0) return -1;
+
+         if (dist[v] + cost < dist[w])
+         {
+            dist[w] = dist[v] + cost;
+            prev[w] = v;
+            if (pq.contains(w))
+               pq.decreaseKey(w, dist[w]);
+            else
+               pq.insert(w, dist[w]);
+         }
+      }
+   }
+   return expanded;
+}
+
+// A* from s to t.  Vertices are taken from the queue in order of distance
+// so far plus heuristic(v), the estimate of the distance left, and the
+// search stops when t is taken.  With a consistent heuristic no vertex is
+// expanded twice and the path is a shortest one.  Returns the number of
+// vertices taken from the queue.
+template <class G, class Heuristic>
+int gridAStar(const G &g, int s, int t, Heuristic heuristic,
+              std::vector<int> &dist, std::vector<int> &prev, IndexMinPQ &pq)
+{
+   int cells = g.cells();
+   int expanded = 0;
+
+   dist.assign(cells, INFINITE_DISTANCE);
+   prev.assign(cells, -1);
+   pq.reset(cells);
+   if (s < 0 || s >= cells || t < 0 || t >= cells) return 0;
+
+   dist[s] = 0;
+   pq.insert(s, heuristic(s));
+   while (!pq.isEmpty())
+   {
+      int v = pq.delMin();
+      expanded++;
+      if (v == t) break;
+
+      for (int k = 0 ; k < GRID_DEGREE ; k++)
+      {
+         int w = g.neighbour(v, k);
+         if (w == NO_NEIGHBOUR) continue;
+         int d = dist[v] + g.cost(w);
+
+         if (d < dist[w])
+         {
+            dist[w] = d;
+            prev[w] = v;
+            int f = d + heuristic(w);
+            if (pq.contains(w))
+               pq.decreaseKey(w, f);
+            else
+               pq.insert(w, f);
+         }
+      }
+   }
+   return expanded;
+}
+#endif
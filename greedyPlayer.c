@@ -0,0 +1,58 @@
+/********************************************************************//**
+ * @file
+ *
+ * A player plugin written in C, as an example of the plugin interface
+ * and a baseline to measure the real players against.  It takes the safe
+ * step that brings the head closest to the food, and gives up when no
+ * step is safe.  It looks no further ahead than that.
+ ***********************************************************************/
+#include <stdlib.h>
+#include "playerPlugin.h"
+
+static void *create(const char *options)
+{
+   (void)options;
+   return malloc(1);
+}
+
+static int makeMove(void *player, const PlayfieldView *view)
+{
+   static const int moves[] = {PLUGIN_LEFT, PLUGIN_RIGHT, PLUGIN_UP,
+                               PLUGIN_DOWN};
+   int x = view->head % view->width, y = view->head / view->width;
+   int foodX = view->food % view->width, foodY = view->food / view->width;
+   int best = PLUGIN_NONE, bestDistance = 0;
+   int i;
+
+   (void)player;
+   for (i = 0 ; i < 4 ; i++)
+   {
+      int nx = x + (i == 0 ? -1 : i == 1 ? 1 : 0);
+      int ny = y + (i == 2 ? 1 : i == 3 ? -1 : 0);
+      int distance;
+
+      if (nx < 0 || nx >= view->width || ny < 0 || ny >= view->height)
+         continue;
+      if (view->grid[ny * view->width + nx] & (TAIL_VALUE | HEAD_VALUE))
+         continue;
+      distance = abs(nx - foodX) + abs(ny - foodY);
+      if (best == PLUGIN_NONE || distance < bestDistance)
+      {
+         best = moves[i];
+         bestDistance = distance;
+      }
+   }
+   return best;
+}
+
+static void destroy(void *player)
+{
+   free(player);
+}
+
+const PlayerPlugin *playerPlugin(void)
+{
+   static const PlayerPlugin plugin = {PLAYER_PLUGIN_ABI, "greedy", create,
+                                       makeMove, destroy};
+   return &plugin;
+}
@@ -0,0 +1,13 @@
+/********************************************************************//**
+ * @file
+ *
+ * Storage type of one playfield cell.  A cell only ever holds one of the
+ * small *_VALUE codes from playfieldView.h, so a byte is enough and a whole
+ * board row fits in far fewer cache lines than with an int per cell.
+ ***********************************************************************/
+#ifndef GRIDCELL_H
+#define GRIDCELL_H
+
+typedef unsigned char GridCell;
+
+#endif
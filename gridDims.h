@@ -0,0 +1,57 @@
+/********************************************************************//**
+ * @file
+ *
+ * Grid dimensions for code that does index arithmetic on the playfield.
+ * GridDims carries a width and height chosen at run time.
+ * FixedGridDims has the same interface with the size as template
+ * arguments, so divisions, bounds and loop trip counts become constants
+ * the compiler can fold and unroll.  withGridDims picks the fixed
+ * version for the common board sizes and the runtime one otherwise.
+ ***********************************************************************/
+#ifndef GRIDDIMS_H
+#define GRIDDIMS_H
+
+/********************************************************************//**
+ * @class GridDims
+ **********************************************************************/
+class GridDims
+{
+   int w, h;
+public:
+   GridDims(int width, int height) : w(width), h(height) {}
+
+   int width() const { return w; }
+   int height() const { return h; }
+   int cells() const { return w * h; }
+   int index(int row, int col) const { return row * w + col; }
+   int row(int cell) const { return cell / w; }
+   int col(int cell) const { return cell % w; }
+};
+
+/********************************************************************//**
+ * @class FixedGridDims
+ **********************************************************************/
+template <int W, int H>
+class FixedGridDims
+{
+public:
+   int width() const { return W; }
+   int height() const { return H; }
+   int cells() const { return W * H; }
+   int index(int row, int col) const { return row * W + col; }
+   int row(int cell) const { return cell / W; }
+   int col(int cell) const { return cell % W; }
+};
+
+// Call f with the dimension type that fits width x height.  f must accept
+// every FixedGridDims listed here as well as GridDims.
+template <class F>
+void withGridDims(int width, int height, F &f)
+{
+   if (width == 17 && height == 15) f(FixedGridDims<17, 15>());
+   else if (width == 32 && height == 32) f(FixedGridDims<32, 32>());
+   else if (width == 64 && height == 64) f(FixedGridDims<64, 64>());
+   else if (width == 256 && height == 256) f(FixedGridDims<256, 256>());
+   else f(GridDims(width, height));
+}
+#endif
@@ -0,0 +1,72 @@
+/********************************************************************//**
+ * @file
+ *
+ * The grid graph concept used by the search templates in graphSearch.h.
+ * A type G models it when, for a const G g,
+ *
+ *    g.cells()           number of cells; vertices are 0 .. cells()-1
+ *    g.neighbour(v, k)   for k in 0 .. GRID_DEGREE-1, the k-th neighbour
+ *                        of the vertex v, or NO_NEIGHBOUR
+ *    g.cost(w)           cost of stepping onto w, never negative for
+ *                        the shortest path searches
+ *
+ * Neighbours are asked for by slot so a search can stop at any point in
+ * a neighbour list and carry on later, which is what an iterative
+ * depth-first search needs.  SnakeGraph and WeightedGraph model the
+ * concept over their stored arrays; ImplicitGrid models it straight from
+ * a playfield grid and never builds an edge.
+ ***********************************************************************/
+#ifndef GRIDGRAPH_H
+#define GRIDGRAPH_H
+#include "gridCell.h"
+#include "gridDims.h"
+
+// Neighbour slots per vertex: up, down, left, right on a grid
+#define GRID_DEGREE 4
+
+// Returned for a neighbour slot that is empty
+#define NO_NEIGHBOUR -1
+
+/********************************************************************//**
+ * @class ImplicitGrid
+ *
+ * The open cells of a playfield grid as a graph, with edges between side
+ * by side cells that are both open.  Neighbours are worked out from the
+ * cell index, and with a FixedGridDims the bounds checks are constants,
+ * so a search over it inlines down to a few compares per neighbour.
+ * Costs come from a table indexed by cell, such as CellWeights::data(),
+ * or are all 1.  Only open cells should be asked for their neighbours.
+ **********************************************************************/
+template <class Dims = GridDims>
+class ImplicitGrid
+{
+   Dims dims;
+   const GridCell *grid;
+   GridCell blocked;
+   const int *costs;
+
+public:
+   ImplicitGrid(const Dims &d, const GridCell *g, GridCell b,
+                const int *c = nullptr)
+      : dims(d), grid(g), blocked(b), costs(c) {}
+
+   const Dims &dimensions() const { return dims; }
+   int cells() const { return dims.cells(); }
+   bool open(int v) const { return grid[v] != blocked; }
+   int cost(int w) const { return costs ? costs[w] : 1; }
+
+   int neighbour(int v, int k) const
+   {
+      int w = NO_NEIGHBOUR;
+      switch (k)
+      {
+         case 0: if (dims.row(v) > 0) w = v - dims.width(); break;
+         case 1: if (dims.row(v) < dims.height() - 1) w = v + dims.width();
+                 break;
+         case 2: if (dims.col(v) > 0) w = v - 1; break;
+         case 3: if (dims.col(v) < dims.width() - 1) w = v + 1; break;
+      }
+      return (w != NO_NEIGHBOUR && grid[w] != blocked) ? w : NO_NEIGHBOUR;
+   }
+};
+#endif
@@ -0,0 +1,676 @@
+/***************************************************************************//**
+ * @file hamiltonCycle.cpp
+ *
+ * @brief functions for the HamiltonCycle implementation
+ *
+ * @par Class
+ *    CSC315 Data Structures
+ ******************************************************************************/
+
+#include "hamiltonCycle.h"
+#include "playfield.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <tuple>
+#include <sys/stat.h>
+#include <unistd.h>
+
+//cells kept free between the head and the tail when taking a shortcut
+#define SHORTCUT_MARGIN 4
+
+//identifies a cache file and the version of its layout
+#define CACHE_MAGIC 0x434d4148
+#define CACHE_VERSION 1
+
+/*************************************************************************//**
+ * @brief Constructor for class HamiltonCycle
+ *
+ * @par Description
+ *   The open cells are the ones that are not TAIL_VALUE, so this should be
+ *   given the board before the snake has grown, when the only blocked cells
+ *   are obstacles. An open rectangle with an even number of cells has a
+ *   cycle that is laid out directly. With obstacles the cycle is found by
+ *   joining smaller cycles; if that fails the board is taken to have no
+ *   cycle and the result is empty.
+ *
+ * @param[in] grid - the playfield
+ * @param[in] w - width of the playfield
+ * @param[in] h - height of the playfield
+ *
+ * @returns an instance of class HamiltonCycle
+ ****************************************************************************/
+HamiltonCycle::HamiltonCycle(const GridCell *grid, int w, int h)
+  : HamiltonCycle(w, h, layoutHash(grid, w, h))
+{
+  std::vector<char> open(w * h);
+  int openCount = 0;
+  for (int i = 0 ; i < w * h ; i++)
+  {
+    open[i] = grid[i] != TAIL_VALUE;
+    openCount += open[i];
+  }
+
+  //a grid is bipartite, so a cycle needs an even number of cells
+  if (w < 2 || h < 2 || openCount < 4 || openCount % 2 != 0)
+    return;
+
+  if (openCount == w * h)
+    buildRectangle();
+  else
+    grow(open);
+}
+
+/*************************************************************************//**
+ * @brief Constructor for an empty cycle
+ *
+ * @param[in] w - width of the playfield
+ * @param[in] h - height of the playfield
+ * @param[in] hash - the layout hash of the playfield
+ *
+ * @returns an instance of class HamiltonCycle with no cells
+ ****************************************************************************/
+HamiltonCycle::HamiltonCycle(int w, int h, uint64_t hash) : width(w),
+  height(h), layout(hash), order(w * h, -1)
+{ }
+
+/*************************************************************************//**
+ * @brief Lays out the cycle on an open rectangle
+ *
+ * @par Description
+ *   Column 0 is kept for the way back. The cycle runs along row 0, then
+ *   snakes back and forth over columns 1 to w - 1 up the board and returns
+ *   down column 0. This closes when the number of rows is even; otherwise
+ *   the same is done with rows and columns swapped.
+ ****************************************************************************/
+void HamiltonCycle::buildRectangle()
+{
+  bool swap = height % 2 != 0;
+  int across = swap ? height : width;
+  int along = swap ? width : height;
+  std::vector<int> path;
+
+  auto cellAt = [&](int a, int b) {
+    return swap ? a * width + b : b * width + a;
+  };
+
+  for (int b = 0 ; b < along ; b++)
+    for (int k = 1 ; k < across ; k++)
+      path.push_back(cellAt(b % 2 == 0 ? k : across - k, b));
+  for (int b = along - 1 ; b >= 0 ; b--)
+    path.push_back(cellAt(0, b));
+
+  setCycle(path);
+}
+
+/*************************************************************************//**
+ * @brief Finds a cycle over the open cells of a board with obstacles
+ *
+ * @par Description
+ *   First every open cell is given two neighbours so the cells fall into
+ *   disjoint cycles (a 2-factor). The board is bipartite like a chessboard,
+ *   so this is a flow problem: each dark cell sends two units to the light
+ *   cells next to it, each light cell takes two, and a maximum flow that
+ *   uses every unit picks the edges. The cycles are then merged: where two
+ *   different cycles run along opposite sides of a 2x2 square, those two
+ *   sides are swapped for the other two, which joins them into one. If
+ *   there is no 2-factor, or the cycles cannot all be merged, the board is
+ *   taken to have no cycle.
+ *
+ * @param[in] open - whether each cell is open
+ *
+ * @returns true if a cycle over every open cell was found
+ ****************************************************************************/
+bool HamiltonCycle::grow(const std::vector<char> &open)
+{
+  int n = width * height;
+  std::vector<int> partner(2 * n, -1);
+  if (!twoFactor(open, partner))
+    return false;
+
+  //label the cycles of the 2-factor; merging two cycles joins their sets
+  std::vector<int> set(n, -1);
+  for (int i = 0 ; i < n ; i++)
+  {
+    if (!open[i] || set[i] >= 0)
+      continue;
+    int prev = -1, cell = i;
+    do
+    {
+      set[cell] = i;
+      int step = (partner[2 * cell] != prev) ? partner[2 * cell] :
+        partner[2 * cell + 1];
+      prev = cell;
+      cell = step;
+    } while (cell != i);
+  }
+
+  auto find = [&set](int x) {
+    while (set[x] != x)
+      x = set[x] = set[set[x]];
+    return x;
+  };
+  auto linked = [&partner](int x, int y) {
+    return partner[2 * x] == y || partner[2 * x + 1] == y;
+  };
+  auto relink = [&partner](int x, int from, int to) {
+    partner[2 * x + (partner[2 * x] == from ? 0 : 1)] = to;
+  };
+
+  bool changed = true;
+  while (changed)
+  {
+    changed = false;
+    for (int row = 0 ; row + 1 < height ; row++)
+      for (int col = 0 ; col + 1 < width ; col++)
+      {
+        int a = row * width + col, b = a + 1;
+        int c = a + width, d = c + 1;
+        if (!open[a] || !open[b] || !open[c] || !open[d])
+          continue;
+
+        //a-b and c-d become a-c and b-d, or a-c and b-d become a-b and c-d
+        if (linked(a, b) && linked(c, d) && find(a) != find(c))
+        {
+          relink(a, b, c); relink(c, d, a);
+          relink(b, a, d); relink(d, c, b);
+        }
+        else if (linked(a, c) && linked(b, d) && find(a) != find(b))
+        {
+          relink(a, c, b); relink(b, d, a);
+          relink(c, a, d); relink(d, b, c);
+        }
+        else
+          continue;
+
+        set[find(a)] = find(d);
+        set[find(b)] = find(c);
+        changed = true;
+      }
+  }
+
+  int start = -1;
+  for (int i = 0 ; i < n ; i++)
+    if (open[i])
+    {
+      if (start < 0)
+        start = i;
+      else if (find(i) != find(start))
+        return false;
+    }
+
+  std::vector<int> path;
+  int prev = -1, cell = start;
+  do
+  {
+    path.push_back(cell);
+    int step = (partner[2 * cell] != prev) ? partner[2 * cell] :
+      partner[2 * cell + 1];
+    prev = cell;
+    cell = step;
+  } while (cell != start);
+
+  setCycle(path);
+  return true;
+}
+
+/*************************************************************************//**
+ * @brief Gives every open cell two neighbours so the cells form cycles
+ *
+ * @par Description
+ *   Dinic's maximum flow from a source through the dark cells (capacity 2),
+ *   the edges to neighbouring light cells (capacity 1) and the light cells
+ *   (capacity 2) to a sink. An edge with flow on it is an edge of the
+ *   2-factor.
+ *
+ * @param[in] open - whether each cell is open
+ * @param[out] partner - the two neighbours of cell i at 2i and 2i + 1
+ *
+ * @returns true if every open cell got two neighbours
+ ****************************************************************************/
+bool HamiltonCycle::twoFactor(const std::vector<char> &open,
+  std::vector<int> &partner) const
+{
+  int n = width * height;
+  int source = n, sink = n + 1;
+  std::vector<int> head(n + 2, -1), to, cap, link;
+  int dark = 0, light = 0;
+
+  auto addEdge = [&](int u, int v, int c) {
+    to.push_back(v); cap.push_back(c); link.push_back(head[u]);
+    head[u] = to.size() - 1;
+    to.push_back(u); cap.push_back(0); link.push_back(head[v]);
+    head[v] = to.size() - 1;
+  };
+
+  for (int i = 0 ; i < n ; i++)
+  {
+    if (!open[i])
+      continue;
+    int col = i % width, row = i / width;
+    if ((col + row) % 2 != 0)
+    {
+      addEdge(i, sink, 2);
+      light++;
+      continue;
+    }
+    addEdge(source, i, 2);
+    dark++;
+    if (row > 0 && open[i - width]) addEdge(i, i - width, 1);
+    if (row < height - 1 && open[i + width]) addEdge(i, i + width, 1);
+    if (col > 0 && open[i - 1]) addEdge(i, i - 1, 1);
+    if (col < width - 1 && open[i + 1]) addEdge(i, i + 1, 1);
+  }
+  if (dark != light)
+    return false;
+
+  std::vector<int> level(n + 2), current(n + 2), queue(n + 2);
+  std::vector<int> stack, edges;
+  int flow = 0;
+
+  while (true)
+  {
+    //label each node with its distance from the source in the residual
+    std::fill(level.begin(), level.end(), -1);
+    int qHead = 0, qTail = 0;
+    queue[qTail++] = source;
+    level[source] = 0;
+    while (qHead < qTail)
+    {
+      int u = queue[qHead++];
+      for (int e = head[u] ; e >= 0 ; e = link[e])
+        if (cap[e] > 0 && level[to[e]] < 0)
+        {
+          level[to[e]] = level[u] + 1;
+          queue[qTail++] = to[e];
+        }
+    }
+    if (level[sink] < 0)
+      break;
+
+    //push single units along shortest paths until the sink is cut off;
+    //every path carries one unit since the cell edges have capacity 1
+    current = head;
+    while (true)
+    {
+      int u = source;
+      edges.clear();
+      while (u != sink)
+      {
+        int &e = current[u];
+        while (e >= 0 && !(cap[e] > 0 && level[to[e]] == level[u] + 1))
+          e = link[e];
+        if (e >= 0)
+        {
+          edges.push_back(e);
+          u = to[e];
+        }
+        else if (u == source)
+          break;
+        else
+        {
+          //dead end: retreat and never try this node again this phase
+          level[u] = -1;
+          int back = edges.back();
+          edges.pop_back();
+          u = to[back ^ 1];
+        }
+      }
+      if (u != sink)
+        break;
+      for (int e : edges)
+      {
+        cap[e]--;
+        cap[e ^ 1]++;
+      }
+      flow++;
+    }
+  }
+
+  if (flow != 2 * dark)
+    return false;
+
+  for (int u = 0 ; u < n ; u++)
+  {
+    if (!open[u] || (u % width + u / width) % 2 != 0)
+      continue;
+    for (int e = head[u] ; e >= 0 ; e = link[e])
+      if (to[e] < n && e % 2 == 0 && cap[e] == 0)
+      {
+        int v = to[e];
+        partner[2 * u + (partner[2 * u] < 0 ? 0 : 1)] = v;
+        partner[2 * v + (partner[2 * v] < 0 ? 0 : 1)] = u;
+      }
+  }
+  return true;
+}
+
+/*************************************************************************//**
+ * @brief Stores a cycle and the position of each of its cells
+ *
+ * @param[in] path - the cells of the cycle in order
+ ****************************************************************************/
+void HamiltonCycle::setCycle(const std::vector<int> &path)
+{
+  cells = path;
+  order.assign(width * height, -1);
+  for (int i = 0 ; i < (int) cells.size() ; i++)
+    order[cells[i]] = i;
+}
+
+/*************************************************************************//**
+ * @brief Checks that the stored cells are a cycle over the open cells
+ *
+ * @param[in] open - whether each cell is open
+ *
+ * @returns true if every open cell is visited once and each step is
+ *          between neighbouring cells
+ ****************************************************************************/
+bool HamiltonCycle::isCycle(const std::vector<char> &open) const
+{
+  int n = width * height;
+  int openCount = 0;
+  for (int i = 0 ; i < n ; i++)
+    openCount += open[i];
+  if ((int) cells.size() != openCount)
+    return false;
+
+  std::vector<char> seen(n, 0);
+  for (int i = 0 ; i < (int) cells.size() ; i++)
+  {
+    int a = cells[i];
+    int b = cells[(i + 1) % cells.size()];
+    if (a < 0 || a >= n || !open[a] || seen[a])
+      return false;
+    seen[a] = 1;
+
+    int step = std::abs(a % width - b % width) +
+      std::abs(a / width - b / width);
+    if (step != 1)
+      return false;
+  }
+  return true;
+}
+
+/*************************************************************************//**
+ * @brief tells whether the board has a cycle
+ *
+ * @returns true if the cycle visits every open cell
+ ****************************************************************************/
+bool HamiltonCycle::valid() const { return !cells.empty(); }
+
+/*************************************************************************//**
+ * @brief gets the number of cells on the cycle
+ *
+ * @returns the length of the cycle
+ ****************************************************************************/
+int HamiltonCycle::length() const { return cells.size(); }
+
+/*************************************************************************//**
+ * @brief gets where a cell is on the cycle
+ *
+ * @param[in] cell - the index of the cell
+ *
+ * @returns the position of the cell, or -1 if it is not on the cycle
+ ****************************************************************************/
+int HamiltonCycle::position(int cell) const { return order[cell]; }
+
+/*************************************************************************//**
+ * @brief gets the cell after a cell on the cycle
+ *
+ * @param[in] cell - the index of a cell on the cycle
+ *
+ * @returns the index of the next cell
+ ****************************************************************************/
+int HamiltonCycle::next(int cell) const
+{
+  return cells[(order[cell] + 1) % cells.size()];
+}
+
+/*************************************************************************//**
+ * @brief gets how far ahead one cell is of another along the cycle
+ *
+ * @param[in] from - the index of a cell on the cycle
+ * @param[in] to - the index of a cell on the cycle
+ *
+ * @returns the number of steps forward from from to to
+ ****************************************************************************/
+int HamiltonCycle::distance(int from, int to) const
+{
+  int n = cells.size();
+  return (order[to] - order[from] + n) % n;
+}
+
+/*************************************************************************//**
+ * @brief Picks the next cell for a snake that follows the cycle
+ *
+ * @par Description
+ *   The body of a snake that only ever moves forward along the cycle lies
+ *   between its tail and its head in cycle order, so every cell ahead of
+ *   the head and behind the tail is free. The head may jump to any such
+ *   neighbour as long as it stays SHORTCUT_MARGIN cells behind the tail
+ *   and does not pass the food. Once the snake covers half the board it
+ *   just follows the cycle. Only the four neighbours of the head are
+ *   looked at, so this takes constant time.
+ *
+ * @param[in] grid - the playfield
+ * @param[in] head - position of the snake's head
+ * @param[in] tail - position of the end of the tail, or the head if the
+ *                   snake has no tail
+ * @param[in] food - position of the food, or -1 if there is none
+ * @param[in] bodyLength - number of tail segments
+ *
+ * @returns the cell to move to
+ ****************************************************************************/
+int HamiltonCycle::shortcut(const GridCell *grid, int head, int tail,
+  int food, int bodyLength) const
+{
+  int n = cells.size();
+  int best = next(head);
+  int bestDistance = 1;
+
+  int toTail = (tail == head) ? n : distance(head, tail);
+  int toFood = (food < 0) ? 1 : distance(head, food);
+  int limit = std::min(toTail - SHORTCUT_MARGIN, toFood);
+  if (2 * (bodyLength + 1) >= n)
+    return best;
+
+  int col = head % width, row = head / width;
+  int neighbours[4] = {
+    (row > 0) ? head - width : -1,
+    (row < height - 1) ? head + width : -1,
+    (col > 0) ? head - 1 : -1,
+    (col < width - 1) ? head + 1 : -1
+  };
+
+  for (int cell : neighbours)
+  {
+    if (cell < 0 || order[cell] < 0 || grid[cell] == TAIL_VALUE)
+      continue;
+
+    int d = distance(head, cell);
+    if (d > bestDistance && d <= limit)
+    {
+      best = cell;
+      bestDistance = d;
+    }
+  }
+  return best;
+}
+
+/*************************************************************************//**
+ * @brief Writes the cycle to a file
+ *
+ * @par Description
+ *   The file holds a header with the size and layout hash followed by the
+ *   cells in cycle order, in the machine's byte order. It is written under
+ *   a temporary name and renamed, so a reader never sees half a file.
+ *
+ * @param[in] path - the file to write
+ *
+ * @returns true if the file was written
+ ****************************************************************************/
+bool HamiltonCycle::save(const std::string &path) const
+{
+  std::ostringstream tmp;
+  tmp << path << "." << getpid() << "."
+      << std::hash<std::thread::id>()(std::this_thread::get_id()) << ".tmp";
+
+  FILE *file = fopen(tmp.str().c_str(), "wb");
+  if (!file)
+    return false;
+
+  int32_t header[4] = {CACHE_MAGIC, CACHE_VERSION, width, height};
+  int32_t count = cells.size();
+  bool ok = fwrite(header, sizeof(header), 1, file) == 1 &&
+    fwrite(&layout, sizeof(layout), 1, file) == 1 &&
+    fwrite(&count, sizeof(count), 1, file) == 1 &&
+    (count == 0 || fwrite(cells.data(), sizeof(int), count, file) ==
+     (size_t) count);
+  ok = fclose(file) == 0 && ok;
+
+  if (ok)
+    ok = rename(tmp.str().c_str(), path.c_str()) == 0;
+  if (!ok)
+    remove(tmp.str().c_str());
+  return ok;
+}
+
+/*************************************************************************//**
+ * @brief Reads a cycle written by save
+ *
+ * @par Description
+ *   The file must be for the same size and layout as this cycle, and a
+ *   non-empty cycle must check out against the layout, so a stale or
+ *   damaged file is never used.
+ *
+ * @param[in] path - the file to read
+ *
+ * @returns true if the cycle was read
+ ****************************************************************************/
+bool HamiltonCycle::load(const std::string &path)
+{
+  FILE *file = fopen(path.c_str(), "rb");
+  if (!file)
+    return false;
+
+  int32_t header[4];
+  uint64_t hash;
+  int32_t count;
+  bool ok = fread(header, sizeof(header), 1, file) == 1 &&
+    fread(&hash, sizeof(hash), 1, file) == 1 &&
+    fread(&count, sizeof(count), 1, file) == 1 &&
+    header[0] == CACHE_MAGIC && header[1] == CACHE_VERSION &&
+    header[2] == width && header[3] == height && hash == layout &&
+    count >= 0 && count <= width * height;
+
+  std::vector<int> stored(ok ? count : 0);
+  if (ok && count > 0)
+    ok = fread(stored.data(), sizeof(int), count, file) == (size_t) count;
+  fclose(file);
+  if (!ok)
+    return false;
+
+  for (int cell : stored)
+    if (cell < 0 || cell >= width * height)
+      return false;
+  setCycle(stored);
+  return true;
+}
+
+/*************************************************************************//**
+ * @brief Hashes the size and obstacles of a playfield
+ *
+ * @par Description
+ *   64 bit FNV-1a over the size and one byte per cell saying whether it is
+ *   blocked. Only TAIL_VALUE cells count, so the head and the food do not
+ *   change the hash.
+ *
+ * @param[in] grid - the playfield
+ * @param[in] w - width of the playfield
+ * @param[in] h - height of the playfield
+ *
+ * @returns the hash
+ ****************************************************************************/
+uint64_t HamiltonCycle::layoutHash(const GridCell *grid, int w, int h)
+{
+  uint64_t hash = 14695981039346656037ULL;
+  auto add = [&hash](unsigned char byte) {
+    hash ^= byte;
+    hash *= 1099511628211ULL;
+  };
+
+  for (int shift = 0 ; shift < 32 ; shift += 8)
+  {
+    add((w >> shift) & 0xff);
+    add((h >> shift) & 0xff);
+  }
+  for (int i = 0 ; i < w * h ; i++)
+    add(grid[i] == TAIL_VALUE);
+  return hash;
+}
+
+/*************************************************************************//**
+ * @brief gets the shared cycle for a playfield layout
+ *
+ * @par Description
+ *   Cycles are kept for the life of the program, keyed by size and layout
+ *   hash, so the reference stays valid. A layout seen for the first time
+ *   is read from the cache directory, or built and written there, so later
+ *   runs skip the work. The directory is $SNAKE_CACHE_DIR, or .snake-cache
+ *   in the working directory. The lock is not held while building, so
+ *   games with different layouts build their cycles in parallel.
+ *
+ * @param[in] grid - the playfield, before the snake has grown
+ * @param[in] w - width of the playfield
+ * @param[in] h - height of the playfield
+ *
+ * @returns the cycle for the layout
+ ****************************************************************************/
+const HamiltonCycle &HamiltonCycle::forBoard(const GridCell *grid, int w,
+  int h)
+{
+  typedef std::tuple<int, int, uint64_t> Key;
+  static std::mutex lock;
+  static std::map<Key, std::unique_ptr<HamiltonCycle>> cycles;
+
+  uint64_t hash = layoutHash(grid, w, h);
+  Key key(w, h, hash);
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    auto found = cycles.find(key);
+    if (found != cycles.end())
+      return *found->second;
+  }
+
+  const char *dir = getenv("SNAKE_CACHE_DIR");
+  std::string directory = dir ? dir : ".snake-cache";
+  std::ostringstream name;
+  name << directory << "/hamilton-" << w << "x" << h << "-" << std::hex
+       << hash << ".bin";
+
+  std::vector<char> open(w * h);
+  for (int i = 0 ; i < w * h ; i++)
+    open[i] = grid[i] != TAIL_VALUE;
+
+  std::unique_ptr<HamiltonCycle> cycle(new HamiltonCycle(w, h, hash));
+  if (!cycle->load(name.str()) ||
+      (cycle->valid() && !cycle->isCycle(open)))
+  {
+    cycle.reset(new HamiltonCycle(grid, w, h));
+    mkdir(directory.c_str(), 0755);
+    cycle->save(name.str());
+  }
+
+  std::lock_guard<std::mutex> guard(lock);
+  std::unique_ptr<HamiltonCycle> &entry = cycles[key];
+  if (!entry)
+    entry = std::move(cycle);
+  return *entry;
+}
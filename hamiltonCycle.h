@@ -0,0 +1,58 @@
+/***************************************************************************//**
+ * @file hamiltonCycle.h
+ *
+ * @brief header file for the Hamiltonian cycle over a playfield
+ *
+ * @par Class
+ *    CSC315 Data Structures
+ ******************************************************************************/
+
+#ifndef HAMILTONCYCLE_H
+#define HAMILTONCYCLE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "gridCell.h"
+
+/*!
+* @brief a cycle that visits every open cell of a playfield once. A snake
+*        that follows the cycle can never trap itself, and it may take a
+*        shortcut to any cell ahead of it on the cycle that is still behind
+*        its tail. The cycle only depends on the size and the obstacles, so
+*        it is built once per layout and cached in memory and on disk.
+*        Boards with no cycle, such as ones with an odd number of open
+*        cells, give an empty cycle.
+*/
+class HamiltonCycle
+{
+  int width, height;
+  uint64_t layout;
+  std::vector<int> order;
+  std::vector<int> cells;
+public:
+  HamiltonCycle(const GridCell *, int, int);
+
+  bool valid() const;
+  int length() const;
+  int position(int) const;
+  int next(int) const;
+  int distance(int, int) const;
+  int shortcut(const GridCell *, int, int, int, int) const;
+
+  bool save(const std::string &) const;
+  bool load(const std::string &);
+
+  static uint64_t layoutHash(const GridCell *, int, int);
+  static const HamiltonCycle &forBoard(const GridCell *, int, int);
+
+private:
+  HamiltonCycle(int, int, uint64_t);
+  void buildRectangle();
+  bool grow(const std::vector<char> &);
+  bool twoFactor(const std::vector<char> &, std::vector<int> &) const;
+  void setCycle(const std::vector<int> &);
+  bool isCycle(const std::vector<char> &) const;
+};
+
+#endif
@@ -0,0 +1,196 @@
+/***************************************************************************//**
+ * @file indexMinPQ.cpp
+ *
+ * @brief functions for the IndexMinPQ implementation
+ *
+ * @par Class
+ *    CSC315 Data Structures
+ ******************************************************************************/
+
+#include "indexMinPQ.h"
+
+/*************************************************************************//**
+ * @brief Constructor for class IndexMinPQ
+ *
+ * @param[in] maxN - the number of indices the queue can hold
+ *
+ * @returns an instance of class IndexMinPQ
+ ****************************************************************************/
+IndexMinPQ::IndexMinPQ(int maxN) : n(0)
+{
+  reset(maxN);
+}
+
+/*************************************************************************//**
+ * @brief empties the queue and resizes it for a new range of indices
+ *
+ * @par Description
+ *   The storage is kept between calls so a queue that is reset to the same
+ *   size does not allocate.
+ *
+ * @param[in] maxN - the number of indices the queue can hold
+ *
+ * @returns none
+ ****************************************************************************/
+void IndexMinPQ::reset(int maxN)
+{
+  n = 0;
+  pq.resize(maxN + 1);
+  keys.resize(maxN);
+  qp.assign(maxN, -1);
+}
+
+/*************************************************************************//**
+ * @brief checks if the queue is empty
+ *
+ * @returns true if there are no indices in the queue
+ ****************************************************************************/
+bool IndexMinPQ::isEmpty() const { return n == 0; }
+
+/*************************************************************************//**
+ * @brief checks if an index is in the queue
+ *
+ * @param[in] i - the index
+ *
+ * @returns true if i is in the queue
+ ****************************************************************************/
+bool IndexMinPQ::contains(int i) const { return qp[i] != -1; }
+
+/*************************************************************************//**
+ * @brief gets the number of indices in the queue
+ *
+ * @returns n - the number of indices in the queue
+ ****************************************************************************/
+int IndexMinPQ::size() const { return n; }
+
+/*************************************************************************//**
+ * @brief inserts an index with its key
+ *
+ * @param[in] i - the index, which must not already be in the queue
+ * @param[in] key - the key of the index
+ *
+ * @returns none
+ ****************************************************************************/
+void IndexMinPQ::insert(int i, pqKey_t key)
+{
+  n++;
+  qp[i] = n;
+  pq[n] = i;
+  keys[i] = key;
+  swim(n);
+}
+
+/*************************************************************************//**
+ * @brief lowers the key of an index already in the queue
+ *
+ * @param[in] i - the index
+ * @param[in] key - the new key, which must not be larger than the old one
+ *
+ * @returns none
+ ****************************************************************************/
+void IndexMinPQ::decreaseKey(int i, pqKey_t key)
+{
+  keys[i] = key;
+  swim(qp[i]);
+}
+
+/*************************************************************************//**
+ * @brief changes the key of an index already in the queue
+ *
+ * @param[in] i - the index
+ * @param[in] key - the new key, which may be larger or smaller than the old
+ *
+ * @returns none
+ ****************************************************************************/
+void IndexMinPQ::changeKey(int i, pqKey_t key)
+{
+  keys[i] = key;
+  swim(qp[i]);
+  sink(qp[i]);
+}
+
+/*************************************************************************//**
+ * @brief removes an index from the queue
+ *
+ * @param[in] i - the index, which must be in the queue
+ *
+ * @returns none
+ ****************************************************************************/
+void IndexMinPQ::remove(int i)
+{
+  int k = qp[i];
+  exch(k, n--);
+  if (k <= n)
+  {
+    swim(k);
+    sink(k);
+  }
+  qp[i] = -1;
+}
+
+/*************************************************************************//**
+ * @brief gets the index with the smallest key
+ *
+ * @returns the index with the smallest key
+ ****************************************************************************/
+int IndexMinPQ::minIndex() const { return pq[1]; }
+
+/*************************************************************************//**
+ * @brief gets the smallest key
+ *
+ * @returns the smallest key in the queue
+ ****************************************************************************/
+pqKey_t IndexMinPQ::minKey() const { return keys[pq[1]]; }
+
+/*************************************************************************//**
+ * @brief removes the index with the smallest key
+ *
+ * @returns the index that was removed
+ ****************************************************************************/
+int IndexMinPQ::delMin()
+{
+  int min = pq[1];
+  exch(1, n--);
+  sink(1);
+  qp[min] = -1;
+  return min;
+}
+
+//Compares the keys at two heap positions
+bool IndexMinPQ::greater(int i, int j) const
+{
+  return keys[pq[i]] > keys[pq[j]];
+}
+
+//Swaps two heap positions and keeps the inverse map up to date
+void IndexMinPQ::exch(int i, int j)
+{
+  int swap = pq[i];
+  pq[i] = pq[j];
+  pq[j] = swap;
+  qp[pq[i]] = i;
+  qp[pq[j]] = j;
+}
+
+//Moves the entry at heap position k up until its parent is smaller
+void IndexMinPQ::swim(int k)
+{
+  while (k > 1 && greater(k / 2, k))
+  {
+    exch(k, k / 2);
+    k = k / 2;
+  }
+}
+
+//Moves the entry at heap position k down until its children are larger
+void IndexMinPQ::sink(int k)
+{
+  while (2 * k <= n)
+  {
+    int j = 2 * k;
+    if (j < n && greater(j, j + 1)) j++;
+    if (!greater(k, j)) break;
+    exch(k, j);
+    k = j;
+  }
+}
@@ -0,0 +1,52 @@
+/***************************************************************************//**
+ * @file indexMinPQ.h
+ *
+ * @brief header file for an indexed min priority queue
+ *
+ * @par Class
+ *    CSC315 Data Structures
+ ******************************************************************************/
+
+#ifndef INDEXMINPQ_H
+#define INDEXMINPQ_H
+
+#include <vector>
+
+//key type of the queue; wide enough to pack two 32 bit keys
+typedef long long pqKey_t;
+
+/*!
+* @brief a binary heap of integer keys associated with the indices
+*        0 .. maxN-1. Each index is in the heap at most once, so changing a
+*        key moves the existing entry instead of pushing a duplicate.
+*/
+class IndexMinPQ
+{
+   std::vector<int> pq;    // heap position -> index
+   std::vector<int> qp;    // index -> heap position, -1 if not in the heap
+   std::vector<pqKey_t> keys;  // index -> key
+   int n;
+
+public:
+   IndexMinPQ(int maxN = 0);
+
+   void reset(int maxN);
+   bool isEmpty() const;
+   bool contains(int) const;
+   int size() const;
+   void insert(int, pqKey_t);
+   void decreaseKey(int, pqKey_t);
+   void changeKey(int, pqKey_t);
+   void remove(int);
+   int minIndex() const;
+   pqKey_t minKey() const;
+   int delMin();
+
+private:
+   bool greater(int, int) const;
+   void exch(int, int);
+   void swim(int);
+   void sink(int);
+};
+
+#endif
@@ -6,21 +6,30 @@ using namespace std;
 
 /***************************************************************************//**
  * Standard startup code.  The first command line argument indicates the time
- * requested per 'ticks' of the timer.  Defaults to 2000ms (2 sec)
+ * requested per 'ticks' of the timer.  Defaults to 2000ms (2 sec); 0 plays as
+ * fast as the game can move.  The second is the number of moves made per
+ * tick, more than one to fast-forward, and the third the number of games to
+ * play one after the other.  The game plays on its own thread and the window
+ * is redrawn FRAME_MSEC apart whatever the tick.
  ******************************************************************************/
 int main(int argc, char *argv[])
 {
    glutInit(&argc, argv);
    int msec = 2000;
    if (argc > 1) msec = atoi(argv[1]);
-   initOpenGL(msec);
+   int ticks = 1, games = 1;
+   if (argc > 2) ticks = atoi(argv[2]);
+   if (argc > 3) games = atoi(argv[3]);
+   setPlayback(msec, ticks, games);
+   initOpenGL(FRAME_MSEC);
 
    glutMainLoop();
+   shutdown();
    return 0;
 }
 
 /**************************************************************************//**
- * Standard OpenGL init plus the delay between ticks (msec)
+ * Standard OpenGL init plus the delay between frames (msec)
  *****************************************************************************/
 void initOpenGL(int msec)
 {
@@ -32,6 +41,11 @@ void initOpenGL(int msec)
    glutInitWindowPosition(50,50);      // initial window  position
    glutCreateWindow(name);      // window title
 
+   // Return from glutMainLoop rather than exit, so the game thread is
+   // stopped before the program ends
+   glutSetOption(GLUT_ACTION_ON_WINDOW_CLOSE,
+                 GLUT_ACTION_GLUTMAINLOOP_RETURNS);
+
    glClearColor(0,255,0,0);              // use green for glClear command
    glBlendFunc(GL_SRC_ALPHA,GL_ONE_MINUS_SRC_ALPHA);
    glEnable(GL_BLEND);
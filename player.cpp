@@ -18,46 +18,54 @@
 #include <stack>
 #include <vector>
 #include "dijkstra.h"
+#include "profile.h"
 #include <iostream>
 
-stack<int> findPathToFood(const int *, int, int);
-std::pair<int, int>getNextMove(stack<int> &);
-ValidMove makeRandomMove(const int *, std::pair<int, int>);
+std::pair<int, int>getNextMove(stack<int> &, int);
+ValidMove getDirection(std::pair<int, int>, std::pair<int, int>);
+ValidMove makeRandomMove(const GridCell *, std::pair<int, int>, int, int);
+
+//Runs the player's path search over the playfield grid, with the
+//dimension type picked by withGridDims
+struct Player::GridSearch
+{
+	Player *player;
+	const GridCell *grid;
+	const CellWeights &weights;
+	int head;
+	int food;
+	template <class Dims> void operator()(const Dims &dims)
+	{
+		ImplicitGrid<Dims> G(dims, grid, TAIL_VALUE, weights.data());
+		if(player->mode != DIJKSTRA)
+			player->astar.searchGrid(G, head, food, dims.width(),
+				weights.min());
+		else
+			player->dijkstra.searchGrid(G, head, food);
+	}
+};
 
 /***************************************************************************//**
  * @brief A constructor for class Player
  *
- * @param none
+ * @param[in] mode - the search used to plan paths
  *
  * @returns Player - instance of class Player
  ******************************************************************************/
 
-Player::Player() {}
+Player::Player(SearchMode mode) : mode(mode), nodesExpanded(0), searches(0),
+	lastLength(-1), turnsSinceFood(0), cycle(nullptr), weights(nullptr) {}
 
 /*************************************************************************//**
- * @brief gets the location of the value in the grid
+ * @brief Returns the direction in which the snake should move on a playfield
  *
- * @par Description
- *   The function traverses through all the elements of the array and returns 
- *   the coordinates of the value in the grid in the form of a pair. If the 
- *   position is not found, it returns a default (0, 0)
- *
- * @param[in] grid - stores the playfield
- * @param[in] value - value to be found in the grid
+ * @param[in] pf - the playfield
  *
- * @returns coordinates of the value in the grid
+ * @returns the direction in which the snake should move
  ****************************************************************************/
-std::pair<int, int> getLocation(const int *grid, int value)
+ValidMove Player::makeMove(const Playfield *pf)
 {
-	//For every row
-   for (int y = 0 ; y < PLAYFIELD_HEIGHT ; y++)
-	   //For every column
-      for (int x = 0 ; x < PLAYFIELD_WIDTH ; x++)
-		//if the value is found
-         if (grid[y * PLAYFIELD_WIDTH + x] == value)
-            return std::pair<int, int>(x, y);
-
-   return std::pair<int, int>(0,0);
+	return makeMove(pf->getView());
 }
 
 /*************************************************************************//**
@@ -65,113 +73,411 @@ std::pair<int, int> getLocation(const int *grid, int value)
  * 	  to the food
  *
  * @par Description
- *   The function has a static stack of type integer that stores the path. It
- *   gets the location of the head of the snake and food from the playfield. If
- *   the stack is empty, a new graph is generated and the shortest path to the 
- *   food is found using dijkstra's algorithm. If no paths are found, a flag is
- *   set. if no flag is set, the snake follow the path till the stack empties.
- *   If flag is set, a random move is made and then the function tries to find
- *   a path again.
+ *   The function reads the location of the head of the snake and food from
+ *   the playfield's view, which the playfield keeps up to date, so the grid
+ *   is never scanned. In the DSTAR_LITE mode the incremental planner is brought up
+ *   to date and asked for the next cell. Otherwise the player keeps a stack
+ *   of type integer that stores the path. If the stack is empty, or the body
+ *   has moved onto the next cell of the path, a new graph is generated and
+ *   the shortest path to the food is found. The snake follows the path till
+ *   the stack empties. If no path is found, a random move is made and the
+ *   function tries to find a path again on the next move. In the SURVIVAL
+ *   mode a new path is only taken if it is safe, and the snake follows its
+ *   tail until one is. In the HAMILTON mode the snake follows the board's
+ *   Hamiltonian cycle, shortcutting where it can, or plays as SURVIVAL if
+ *   the board has no cycle.
  *
- * @param[in] pf - the playfield
+ * @param[in] view - the playfield's view
  *
  * @returns the direction in which the snake should move
  ****************************************************************************/
-ValidMove Player::makeMove(const Playfield *pf)
+ValidMove Player::makeMove(const PlayfieldView &view)
 {
-	bool flag = false; 
-	static stack<int> path; //Stores the path the snake should follow
+	const GridCell *grid = view.grid;
+	int width = view.width;
+	int height = view.height;
 
-	const int *grid = pf->getGrid();
+	int head_index = view.head;
+	int food_index = view.food;
+	std::pair<int, int> head(head_index % width, head_index / width);
 
-   	std::pair<int, int> head = getLocation(grid, HEAD_VALUE);
-   	std::pair<int, int> food = getLocation(grid, FOOD_VALUE);
+	//The snake fills the board and there is no food to go to
+	if(food_index < 0)
+		return makeRandomMove(grid, head, width, height);
 
-	int head_index = head.second * PLAYFIELD_WIDTH + head.first;
-	int food_index = food.second * PLAYFIELD_WIDTH + food.first;
-	
-	//Find path to the food
-	if(path.empty())
+	if(mode == DSTAR_LITE)
 	{
-		path = findPathToFood(grid, head_index, food_index);
+		int next = planIncremental(view, head_index, food_index);
 
-		//Could not find a path as the path is blocked by its own body
-		if(path.empty())
+		//The body blocks every path to the food
+		if(next < 0)
+			return makeRandomMove(grid, head, width, height);
+
+		return getDirection(head, std::pair<int, int>(next % width,
+			next / width));
+	}
+
+	if(mode == HAMILTON)
+	{
+		//The cycle depends only on the obstacles, so it is looked up on the
+		//first move, before the snake has grown
+		if(!cycle)
 		{
-			flag = true;
+			PhaseTimer timer(PHASE_GRAPH);
+			cycle = &HamiltonCycle::forBoard(grid, width, height);
+		}
+
+		if(cycle->valid())
+		{
+			PhaseTimer timer(PHASE_PATH);
+			int tail = (view.length > 0) ? bodyCell(view, 0) : head_index;
+			int next = cycle->shortcut(grid, head_index, tail, food_index,
+				view.length);
+			return getDirection(head, std::pair<int, int>(next % width,
+				next / width));
 		}
 	}
-	
 
-	if(flag)
+	if(view.length != lastLength)
+	{
+		lastLength = view.length;
+		turnsSinceFood = 0;
+	}
+	else
+	{
+		turnsSinceFood++;
+	}
+
+	//Throw the path away if the body has moved into it or it does not
+	//start next to the head
+	if(!path.empty() && (grid[path.top()] == TAIL_VALUE ||
+		getDirection(head, std::pair<int, int>(path.top() % width,
+			path.top() / width)) == NONE))
 	{
-		flag = false;
-		ValidMove move = makeRandomMove(grid, head);
-		return move;
+		path = stack<int>();
 	}
 	
-	//Follow the path
-	if(!path.empty())
+	//Find path to the food
+	if(path.empty())
 	{
-		std::pair<int, int> next_move = getNextMove(path);
-		
-		//If in the same column
-		if(next_move.first == head.first)
+		path = findPathToFood(grid, width, height, head_index, food_index);
+
+		if(mode == SURVIVAL || mode == HAMILTON)
 		{
-			//If the food is in the upper section
-			if(next_move.second > head.second)
+			PhaseTimer timer(PHASE_SAFETY);
+			if(open.getWidth() != width || open.getHeight() != height)
+				open.resize(width, height);
+			open.fromGrid(grid, TAIL_VALUE);
+			open.reset(head_index);
+
+			//Only take a path that leaves a way out, unless the snake has
+			//gone round so long without eating that it is time to risk it
+			if(!path.empty() && turnsSinceFood < width * height &&
+				!pathIsSafe(view, path))
 			{
-				return UP;
+				path = stack<int>();
 			}
-			else
+
+			if(path.empty())
 			{
-				return DOWN;
+				ValidMove move = followTail(view);
+				if(move != NONE)
+					return move;
 			}
 		}
-		//If in the same row
-		else if(next_move.second == head.second)
+
+		//Could not find a path as the path is blocked by its own body
+		if(path.empty())
+			return makeRandomMove(grid, head, width, height);
+	}
+	
+	//Follow the path
+	return getDirection(head, getNextMove(path, width));
+}
+
+/*************************************************************************//**
+ * @brief Gets the direction that moves the head onto a neighbouring cell
+ *
+ * @param[in] head - the col and row of the head
+ * @param[in] next_move - the col and row of the cell to move to
+ *
+ * @returns the direction, or NONE if the cell is not next to the head
+ ****************************************************************************/
+ValidMove getDirection(std::pair<int, int> head, std::pair<int, int> next_move)
+{
+	//If in the same column
+	if(next_move.first == head.first)
+	{
+		//If the cell is in the upper section
+		if(next_move.second == head.second + 1)
+			return UP;
+		if(next_move.second == head.second - 1)
+			return DOWN;
+	}
+	//If in the same row
+	else if(next_move.second == head.second)
+	{
+		//if the cell is in the right section
+		if(next_move.first == head.first + 1)
+			return RIGHT;
+		if(next_move.first == head.first - 1)
+			return LEFT;
+	}
+	//Not a neighbour of the head
+	return NONE;
+}
+
+/*************************************************************************//**
+ * @brief Brings the incremental planner up to date and gets the next cell
+ *
+ * @par Description
+ *   If the food is where it was on the last move and the head moved by one
+ *   cell, the planner keeps its search state: the start moves to the new
+ *   head and only the cells the playfield changed on the last move are
+ *   updated. Otherwise the planner starts over from the new food.
+ *
+ * @param[in] view - the playfield's view
+ * @param[in] head_index - position of the snake's head
+ * @param[in] food_index - position of the food
+ *
+ * @returns the next cell to move to, or -1 if the food cannot be reached
+ ****************************************************************************/
+int Player::planIncremental(const PlayfieldView &view, int head_index,
+	int food_index)
+{
+	const GridCell *grid = view.grid;
+	int width = view.width;
+	int height = view.height;
+	int last = dstar.getStart();
+	bool resume = dstar.getGoal() == food_index && last >= 0 &&
+		dstar.getWidth() == width && dstar.getHeight() == height &&
+		getDirection(std::pair<int, int>(last % width, last / width),
+			std::pair<int, int>(head_index % width,
+			head_index / width)) != NONE;
+
+	PhaseTimer searchTimer(PHASE_SEARCH);
+	if(resume)
+	{
+		dstar.moveStart(head_index);
+		for(int i = 0; i < view.changedCount; i++)
+			dstar.updateCell(view.changed[i], grid[view.changed[i]] == TAIL_VALUE);
+	}
+	else
+	{
+		dstar.reset(grid, width, height, head_index, food_index);
+	}
+
+	dstar.computeShortestPath();
+	searchTimer.stop();
+	searches++;
+	nodesExpanded += dstar.expanded();
+	profileNodes(dstar.expanded());
+
+	PhaseTimer pathTimer(PHASE_PATH);
+	return dstar.nextStep();
+}
+
+/*************************************************************************//**
+ * @brief Checks that the snake could still reach its tail after following
+ * 	  a path to the food
+ *
+ * @par Description
+ *   The body is moved along the path on a snapshot of the open cells: each
+ *   step the head covers a cell and the end of the tail frees one, except
+ *   on the last step, where the snake eats and grows. The path is safe if,
+ *   at the food, the head can reach a cell next to where the tail then is,
+ *   since the tail keeps moving away and opening a way out.
+ *
+ * @param[in] view - the playfield's view of the snake
+ * @param[in] steps - the path to the food, next cell on top
+ *
+ * @returns true if the tail can be reached once the food is eaten
+ ****************************************************************************/
+bool Player::pathIsSafe(const PlayfieldView &view, stack<int> steps)
+{
+	int length = view.length;
+	route.clear();
+	while(!steps.empty())
+	{
+		route.push_back(steps.top());
+		steps.pop();
+	}
+
+	//The body from the end of the tail to the head, followed by the path,
+	//is the order in which the snake covers cells and frees them again
+	int k = route.size();
+	auto cellAt = [&](int i) {
+		if(i < length) return bodyCell(view, i);
+		if(i == length) return view.head;
+		return route[i - length - 1];
+	};
+
+	snapshot.take(open);
+	for(int i = 1 ; i <= k ; i++)
+	{
+		snapshot.reset(route[i - 1]);
+		if(i < k)
+			snapshot.set(cellAt(i - 1));
+	}
+
+	return tailIsReachable(route[k - 1], cellAt(k - 1));
+}
+
+/*************************************************************************//**
+ * @brief Picks a move that keeps the tail in reach
+ *
+ * @par Description
+ *   Each open neighbour of the head is tried on a snapshot of the board by
+ *   moving the body one step. Moves that leave the tail reachable are
+ *   preferred, and among them the one furthest from the tail, so the
+ *   snake spends the turn using up space rather than crowding its tail.
+ *   If no move is safe the one with the most room is taken.
+ *
+ * @param[in] view - the playfield's view of the snake
+ *
+ * @returns the direction to move in, or NONE if every neighbour is blocked
+ ****************************************************************************/
+ValidMove Player::followTail(const PlayfieldView &view)
+{
+	const ValidMove moves[] = {UP, DOWN, LEFT, RIGHT};
+	const int dCol[] = {0, 0, -1, 1};
+	const int dRow[] = {1, -1, 0, 0};
+	int width = view.width;
+	int length = view.length;
+	int col = view.head % width;
+	int row = view.head / width;
+	ValidMove best = NONE;
+	bool bestSafe = false;
+	int bestScore = -1;
+
+	for(int d = 0 ; d < 4 ; d++)
+	{
+		int c = col + dCol[d];
+		int r = row + dRow[d];
+		if(c < 0 || c >= width || r < 0 || r >= view.height)
+			continue;
+
+		int next = r * width + c;
+		if(!open.test(next))
+			continue;
+
+		//Move the body one step; the end of the tail frees its cell unless
+		//the snake eats
+		int tail = -1;
+		snapshot.take(open);
+		snapshot.reset(next);
+		if(next == view.food)
+			tail = (length > 0) ? bodyCell(view, 0) : view.head;
+		else if(length > 0)
 		{
-			//if the food is in the right section
-			if(next_move.first > head.first)
-			{
-				return RIGHT;
-			}
-			else
-			{
-				return LEFT;
-			}
+			snapshot.set(bodyCell(view, 0));
+			tail = (length > 1) ? bodyCell(view, 1) : view.head;
+		}
+
+		bool safe = tail < 0 || tailIsReachable(next, tail);
+		int score;
+		if(safe)
+			score = (tail < 0) ? 0 : abs(c - tail % width) +
+				abs(r - tail / width);
+		else
+			score = snapshot.board().reachable(next, region);
+
+		if((safe && !bestSafe) || (safe == bestSafe && score > bestScore))
+		{
+			best = moves[d];
+			bestSafe = safe;
+			bestScore = score;
 		}
 	}
-	//No move found
-   	return NONE;
+	return best;
+}
+
+/*************************************************************************//**
+ * @brief Checks whether the head can get next to the tail on the snapshot
+ *
+ * @param[in] head - position of the head
+ * @param[in] tail - position of the end of the tail
+ *
+ * @returns true if an open cell reachable from the head, or the head
+ * 	    itself, is next to the tail and the head is not boxed in
+ ****************************************************************************/
+bool Player::tailIsReachable(int head, int tail)
+{
+	const Bitboard &board = snapshot.board();
+	int width = board.getWidth();
+	int height = board.getHeight();
+
+	if(board.reachable(head, region) == 0)
+		return false;
+
+	int col = tail % width;
+	int row = tail / width;
+	return (col > 0 && region.test(tail - 1)) ||
+		(col < width - 1 && region.test(tail + 1)) ||
+		(row > 0 && region.test(tail - width)) ||
+		(row < height - 1 && region.test(tail + width));
 }
 
 /*************************************************************************//**
  * @brief Finds the path to the food
  *
  * @par Description
- *   The function creates a weighted graph from the grid and then uses
- *   Dijkstra's algorithm to find the shortest paths to all the nodes from the
- *   head index. If a path is found to the food, it is stored in a stack.
+ *   The function searches the grid in place, as an ImplicitGrid weighted by
+ *   the CellWeights table, with Dijkstra's algorithm or A* (for the other
+ *   modes) to find the shortest path from the head index to the food. No
+ *   graph is built; the neighbours of a cell are worked out as the search
+ *   reaches it. If a path is found to the food, it is stored in a stack.
+ *   The number of vertices the search expanded is added to the player's
+ *   total.
  *
  * @param[in] grid - stores the playfield
+ * @param[in] width - the width of the playfield
+ * @param[in] height - the height of the playfield
  * @param[in] head_index - position of the snake's head
  * @param[in] food-index - position of the food
  *
  * @returns the path to the food stored in a stack
  ****************************************************************************/
-stack<int> findPathToFood(const int *grid, int head_index, int food_index)
+stack<int> Player::findPathToFood(const GridCell *grid, int width,
+	int height, int head_index, int food_index)
 {
 	stack<int> path;
-	
-	//create a weighted graph
-	WeightedGraph *G = new WeightedGraph(grid, PLAYFIELD_WIDTH, PLAYFIELD_HEIGHT);
-	//find the shortest paths using dijkstra's algorithm
-	DijkstraSP dijk(G, head_index);
+	searches++;
+
+	//the cell weights are all the graph there is; the shared table is
+	//only looked up again when the board size changes
+	PhaseTimer graphTimer(PHASE_GRAPH);
+	if(!weights || weights->Width() != width || weights->Height() != height)
+		weights = &CellWeights::forSize(width, height);
+	GridSearch search = {this, grid, *weights, head_index, food_index};
+	graphTimer.stop();
+
+	//search with constant dimensions for the common board sizes
+	{
+		PhaseTimer timer(PHASE_SEARCH);
+		withGridDims(width, height, search);
+	}
+
+	if(mode != DIJKSTRA)
+	{
+		//the shortest path guided by the distance to the food
+		nodesExpanded += astar.expanded();
+		profileNodes(astar.expanded());
+
+		PhaseTimer timer(PHASE_PATH);
+		if(astar.hasPathTo(food_index))
+			path = astar.pathTo(food_index);
+		return path;
+	}
+
+	//the shortest path using dijkstra's algorithm, stopping at the food
+	nodesExpanded += dijkstra.expanded();
+	profileNodes(dijkstra.expanded());
 	
 	//If a path to the food is found 
-	if(dijk.hasPathTo(food_index))
-		path = dijk.pathTo(food_index); //retrieve the path
+	PhaseTimer timer(PHASE_PATH);
+	if(dijkstra.hasPathTo(food_index))
+		path = dijkstra.pathTo(food_index); //retrieve the path
 
 	return path;
 }
@@ -184,16 +490,17 @@ stack<int> findPathToFood(const int *grid, int head_index, int food_index)
  *   the coordinates of the index.
  *
  * @param[in, out] path - a stack storing the path to the food
+ * @param[in] width - the width of the playfield
  *
  * @returns the col and row of the next position
  ****************************************************************************/
 
-std::pair<int, int> getNextMove(stack<int> &path)
+std::pair<int, int> getNextMove(stack<int> &path, int width)
 {
 	int next_move = path.top();
 	path.pop();
 
-	return std::pair<int, int>(next_move % PLAYFIELD_WIDTH, next_move / PLAYFIELD_WIDTH);
+	return std::pair<int, int>(next_move % width, next_move / width);
 }
 
 /*************************************************************************//**
@@ -206,32 +513,35 @@ std::pair<int, int> getNextMove(stack<int> &path)
  *
  * @param[in] grid - stores the playfield
  * @param[in] head - the col and row of the head index
+ * @param[in] width - the width of the playfield
+ * @param[in] height - the height of the playfield
  *
  * @returns the direction in which the snake should move
  ****************************************************************************/
 
-ValidMove makeRandomMove(const int *grid, std::pair<int, int> head)
+ValidMove makeRandomMove(const GridCell *grid, std::pair<int, int> head,
+	int width, int height)
 {
 	if(head.second - 1 >= 0 &&
-		grid[(head.second - 1) * PLAYFIELD_WIDTH + head.first] == 0)
+		grid[(head.second - 1) * width + head.first] == 0)
 	{
 		return DOWN;
 	}
 
-	if(head.second + 1 < PLAYFIELD_HEIGHT &&
-		grid[(head.second + 1) * PLAYFIELD_WIDTH + head.first] == 0)
+	if(head.second + 1 < height &&
+		grid[(head.second + 1) * width + head.first] == 0)
 	{
 		return UP;
 	}
 
 	if(head.first - 1 >= 0 &&
-		grid[head.second * PLAYFIELD_WIDTH + (head.first - 1)] == 0)
+		grid[head.second * width + (head.first - 1)] == 0)
 	{
 		return LEFT;
 	}
 
-	if(head.first + 1 < PLAYFIELD_WIDTH &&
-		grid[head.second * PLAYFIELD_WIDTH + (head.first + 1)] == 0)
+	if(head.first + 1 < width &&
+		grid[head.second * width + (head.first + 1)] == 0)
 	{
 		return RIGHT;
 	}
@@ -239,6 +549,26 @@ ValidMove makeRandomMove(const int *grid, std::pair<int, int> head)
 	return NONE;
 }
 
+/*************************************************************************//**
+ * @brief gets the number of vertices expanded by all searches so far
+ *
+ * @param[in] none
+ *
+ * @returns nodesExpanded - total expanded vertices
+ ****************************************************************************/
+
+long Player::getNodesExpanded() const { return nodesExpanded; }
+
+/*************************************************************************//**
+ * @brief gets the number of path searches run so far
+ *
+ * @param[in] none
+ *
+ * @returns searches - number of searches
+ ****************************************************************************/
+
+long Player::getSearches() const { return searches; }
+
 /*************************************************************************//**
  * @brief Destructor
  *
@@ -18,21 +18,61 @@
 #define __PLAYER_H
 #include <list>
 #include <queue>
+#include <stack>
 #include <vector>
 #include "playfield.h"
+#include "strategy.h"
+#include "dijkstra.h"
+#include "astar.h"
+#include "dstarLite.h"
+#include "bitboard.h"
+#include "hamiltonCycle.h"
+
+/*!
+* @brief the search used to plan a path to the food. SURVIVAL plans with
+*        A* but only takes a path if the snake can still reach its tail
+*        once it has eaten, and follows its tail otherwise. HAMILTON
+*        follows a Hamiltonian cycle of the board, taking shortcuts that
+*        cannot trap the snake, and plays as SURVIVAL on boards without one.
+*/
+enum SearchMode {DIJKSTRA, ASTAR, DSTAR_LITE, SURVIVAL, HAMILTON};
 
 /*!
 * @brief contains data necessary to describe the snake player
 */
 
-class Player
+class Player : public Strategy
 {
 public:
-   Player ();
+   Player (SearchMode mode = DIJKSTRA);
    ValidMove makeMove(const Playfield *);
+   ValidMove makeMove(const PlayfieldView &);
+   long getNodesExpanded() const;
+   long getSearches() const;
    ~Player();
 private:
-	vector<vector<int>> weights;
+   stack<int> findPathToFood(const GridCell *, int, int, int, int);
+   int planIncremental(const PlayfieldView &, int, int);
+   bool pathIsSafe(const PlayfieldView &, stack<int>);
+   ValidMove followTail(const PlayfieldView &);
+   bool tailIsReachable(int, int);
+
+   struct GridSearch;
+   SearchMode mode;
+   long nodesExpanded;
+   long searches;
+   DijkstraSP dijkstra;
+   AStarSP astar;
+   DStarLite dstar;
+   stack<int> path;
+   Bitboard open;
+   Bitboard region;
+   BoardSnapshot snapshot;
+   vector<int> route;
+   int lastLength;
+   int turnsSinceFood;
+   const HamiltonCycle *cycle;
+   const CellWeights *weights;
 };
 
 
@@ -0,0 +1,40 @@
+/********************************************************************//**
+ * @file
+ *
+ * Exports the built-in Player through the plugin interface, so
+ * libPlayer.so can be loaded by dlopen like any other strategy.  The
+ * options string is a search mode name; an empty one is dijkstra.
+ ***********************************************************************/
+#include <cstring>
+#include "player.h"
+#include "playerPlugin.h"
+
+static void *create(const char *options)
+{
+   static const char *names[] = {"dijkstra", "astar", "dstar", "survival",
+                                 "hamilton"};
+   static const SearchMode modes[] = {DIJKSTRA, ASTAR, DSTAR_LITE, SURVIVAL,
+                                      HAMILTON};
+
+   if (options == NULL || *options == '\0') return new Player(DIJKSTRA);
+   for (int i = 0 ; i < 5 ; i++)
+      if (strcmp(options, names[i]) == 0) return new Player(modes[i]);
+   return NULL;
+}
+
+static int makeMove(void *player, const PlayfieldView *view)
+{
+   return static_cast<Player *>(player)->makeMove(*view);
+}
+
+static void destroy(void *player)
+{
+   delete static_cast<Player *>(player);
+}
+
+extern "C" const PlayerPlugin *playerPlugin(void)
+{
+   static const PlayerPlugin plugin = {PLAYER_PLUGIN_ABI, "player", create,
+                                       makeMove, destroy};
+   return &plugin;
+}
@@ -0,0 +1,46 @@
+/********************************************************************//**
+ * @file
+ *
+ * C interface of a player plugin.  A plugin is a shared library that
+ * exports playerPlugin(), which returns a table of three functions: create
+ * makes a player from an options string, makeMove returns the move it
+ * wants on a PlayfieldView, and destroy frees it.  Moves are the ValidMove
+ * codes below.  Each player is only used by one thread at a time, but a
+ * plugin may have players on several threads at once.
+ ***********************************************************************/
+#ifndef PLAYERPLUGIN_H
+#define PLAYERPLUGIN_H
+#include "playfieldView.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Bumped whenever PlayerPlugin or PlayfieldView changes */
+#define PLAYER_PLUGIN_ABI 1
+
+/* Name of the function a plugin exports */
+#define PLAYER_PLUGIN_ENTRY "playerPlugin"
+
+/* Moves, with the values of ValidMove */
+#define PLUGIN_NONE 0
+#define PLUGIN_LEFT 1
+#define PLUGIN_RIGHT 2
+#define PLUGIN_UP 3
+#define PLUGIN_DOWN 4
+
+typedef struct PlayerPlugin
+{
+   int abi;             /* PLAYER_PLUGIN_ABI when the plugin was built */
+   const char *name;
+   void *(*create)(const char *options);   /* NULL if options are bad */
+   int (*makeMove)(void *player, const PlayfieldView *view);
+   void (*destroy)(void *player);
+} PlayerPlugin;
+
+const PlayerPlugin *playerPlugin(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -5,6 +5,11 @@
 #include <iostream>
 #include <iomanip>
 
+// Most obstacles pass a local test.  The rest are checked on the whole
+// board, until these many cells have been visited by those checks, which
+// keeps the time to build a large board linear in its size.
+#define OBSTACLE_CHECK_CELLS (1 << 16)
+
 unsigned long mix(unsigned long a, unsigned long b, unsigned long c)
 {
     a=a-b;  a=a-c;  a=a^(c >> 13);
@@ -19,40 +24,45 @@ unsigned long mix(unsigned long a, unsigned long b, unsigned long c)
     return c;
 }
 
-Playfield::Playfield(bool obst) : tailLength(0), cellWidth(0), cellHeight(0),
-   hasObstacles(obst)
+// Seed from the clock and process id so every game is different
+Playfield::Playfield(bool obst)
+   : Playfield(obst, mix(clock(), time(NULL), getpid()))
+{ }
+
+// Default sized playfield with a fixed seed
+Playfield::Playfield(bool obst, uint64_t seed)
+   : Playfield(PLAYFIELD_WIDTH, PLAYFIELD_HEIGHT, obst, seed)
+{ }
+
+// The seed drives every random choice the playfield makes, so two
+// playfields built with the same seed play out identically for the same
+// moves.  The generator is per instance, so playfields on different
+// threads do not share anything.
+Playfield::Playfield(int w, int h, bool obst, uint64_t seed,
+   double density) : width(w), height(h), tail(w * h), tailStart(0),
+   tailCount(0), tailLength(0), hasObstacles(obst),
+   obstacleDensity(density), rng(seed), observer(NULL)
 {
-   // Seed pseudo-random generator
-   srand(mix(clock(), time(NULL), getpid()));
+   grid = new GridCell[width * height];
+   freeCells.reserve(width * height);
+   freeIndex.resize(width * height);
+   changedCells.reserve(4);
 
-   // Start head of snake in the middle of the playfield
-   head = std::pair<int, int>(rand() % PLAYFIELD_WIDTH, rand() % PLAYFIELD_HEIGHT);
-   food = std::pair<int, int>(rand() % PLAYFIELD_WIDTH, rand() % PLAYFIELD_HEIGHT);
-#ifdef GRAPHICS
-   cellWidth = glutGet(GLUT_WINDOW_WIDTH) / PLAYFIELD_WIDTH;
-   cellHeight = glutGet(GLUT_WINDOW_HEIGHT) / PLAYFIELD_HEIGHT;
-#else
-   cellWidth = 1;
-   cellHeight = 1;
-#endif
+   clearGrid();
+   placeObstacles();
 
-   int count;
-   grid = new int[PLAYFIELD_WIDTH * PLAYFIELD_HEIGHT];
+   // Start the head and the food on random open cells
+   int cell = randomFreeCell();
+   head = std::pair<int, int>(cell % width, cell / width);
+   setCell(cell, HEAD_VALUE);
+   food = placeNewFood();
 
-   do
-   {
-      std::memset(grid, CLEAR_VALUE, sizeof(int)*PLAYFIELD_WIDTH*PLAYFIELD_HEIGHT);
-      placeObstacles();
-      SnakeGraph graph(grid, PLAYFIELD_WIDTH, PLAYFIELD_HEIGHT);
-      Biconnected bicon(&graph);
-      CC cc(&graph);
-      count = cc.count() + bicon.articulationNodes().size(); 
-   } while (count > 1);
-
-   grid[head.first + head.second * PLAYFIELD_WIDTH] = HEAD_VALUE;
-   grid[food.first + food.second * PLAYFIELD_WIDTH] = FOOD_VALUE;
+   view.width = width;
+   view.height = height;
+   view.body = tail.data();
+   view.bodyCapacity = tail.size();
+   view.grid = grid;
    updatePlayfield();
-   drawObstacles();
 }
 
 Playfield::~Playfield()
@@ -60,58 +70,224 @@ Playfield::~Playfield()
    delete[] grid;
 }
 
-void Playfield::drawObstacles()
+// Report every cell changed from now on to observer, or stop reporting
+// if it is NULL.  The observer is first told about the whole board, so it
+// can start at any turn.  The playfield does not own the observer.
+void Playfield::setObserver(PlayfieldObserver *obs)
 {
-   for (int cell = 0 ; cell < PLAYFIELD_WIDTH * PLAYFIELD_HEIGHT ; cell++)
-   {
+   observer = obs;
+   drawBoard();
+}
+
+// Ask the observer to show the board as it is now
+void Playfield::draw()
+{
+   if (observer) observer->show();
+}
+
+// Report the obstacles, the body, the head and the food
+void Playfield::drawBoard()
+{
+   std::vector<char> body(width * height, 0);
+   for (int i = 0 ; i < tailCount ; i++)
+      body[tail[(tailStart + i) % tail.size()]] = 1;
+
+   for (int cell = 0 ; cell < width * height ; cell++)
       if (grid[cell] == TAIL_VALUE)
+         notify(cell, body[cell] ? CELL_BODY : CELL_OBSTACLE);
+
+   notify(view.head, CELL_HEAD);
+   notify(view.food, CELL_FOOD);
+}
+
+// Tell the observer, if there is one, that a cell on the board changed
+void Playfield::notify(int cell, CellState state)
+{
+   if (observer && cell >= 0) observer->cellChanged(cell, state);
+}
+
+// Place obstacles one at a time so the open cells stay biconnected: no
+// single cell, the snake included, can cut the board in two.  An open
+// rectangle is biconnected and every obstacle is only placed if it keeps
+// it that way, so the board never has to be thrown away and built again.
+// Cells are tried in random order and each is tried once, so this always
+// ends, with fewer obstacles than asked for if the board runs out of
+// places to put them.
+void Playfield::placeObstacles()
+{
+   if (!hasObstacles) return;
+   int obstacleCount = obstacleDensity * width * height;
+   int checks = OBSTACLE_CHECK_CELLS / (width * height);
+   Biconnected bicon;
+
+   std::vector<int> order(freeCells);
+   for (int i = order.size() - 1 ; i > 0 ; i--)
+      std::swap(order[i], order[rng.uniform(i + 1)]);
+
+   for (int cell : order)
+   {
+      if (obstacleCount == 0) break;
+
+      // A cell whose eight neighbours are all open can always be taken.
+      // A cell that would leave a neighbour with one way in never can.
+      // Anything else is checked on the whole board, as often as the
+      // budget allows; small boards get many checks, huge ones none.
+      if (ringIsOpen(cell))
+      {
+         setCell(cell, TAIL_VALUE);
+         obstacleCount--;
+      }
+      else if (checks > 0 && keepsNeighboursLinked(cell))
       {
-#ifdef GRAPHICS
-         std::pair<int, int> obstacle(cell % PLAYFIELD_WIDTH, cell / PLAYFIELD_WIDTH);
-         DrawFilledRectangle(obstacle, cellWidth, cellHeight, BLUE);
-#endif
+         checks--;
+         setCell(cell, TAIL_VALUE);
+         bicon.analyze(grid, width, height, TAIL_VALUE);
+         if (bicon.count() + bicon.articulationCount() <= 1)
+            obstacleCount--;
+         else
+            setCell(cell, CLEAR_VALUE);
       }
    }
 }
 
-void Playfield::placeObstacles()
+// Whether the eight cells around a cell are all on the board and open.
+// They form a cycle, so if the cell is blocked its open neighbours stay
+// joined even without any one other cell, and a board that was
+// biconnected stays biconnected.
+bool Playfield::ringIsOpen(int cell) const
 {
-   if (!hasObstacles) return;
-   int obstacleCount = 0.05 * PLAYFIELD_WIDTH * PLAYFIELD_HEIGHT;
+   int col = cell % width, row = cell / width;
+   if (col == 0 || col == width - 1 || row == 0 || row == height - 1)
+      return false;
 
-   while (obstacleCount--)
+   for (int dr = -1 ; dr <= 1 ; dr++)
+      for (int dc = -1 ; dc <= 1 ; dc++)
+         if (grid[cell + dr * width + dc] != CLEAR_VALUE && (dr || dc))
+            return false;
+   return true;
+}
+
+// Whether every open neighbour of a cell would still have two open
+// neighbours of its own if the cell were blocked, which any biconnected
+// board needs
+bool Playfield::keepsNeighboursLinked(int cell) const
+{
+   int col = cell % width, row = cell / width;
+   const int dCol[] = {0, 0, -1, 1};
+   const int dRow[] = {-1, 1, 0, 0};
+
+   for (int d = 0 ; d < 4 ; d++)
    {
-      int placement;
-      do
+      int c = col + dCol[d], r = row + dRow[d];
+      if (c < 0 || c >= width || r < 0 || r >= height) continue;
+      if (grid[r * width + c] == TAIL_VALUE) continue;
+
+      int open = 0;
+      for (int e = 0 ; e < 4 ; e++)
       {
-         placement = rand() % (PLAYFIELD_WIDTH * PLAYFIELD_HEIGHT);
-      } while (grid[placement] != CLEAR_VALUE);
-      grid[placement] = TAIL_VALUE;
+         int nc = c + dCol[e], nr = r + dRow[e];
+         if (nc < 0 || nc >= width || nr < 0 || nr >= height) continue;
+         if (nr * width + nc == cell) continue;
+         if (grid[nr * width + nc] != TAIL_VALUE) open++;
+      }
+      if (open < 2) return false;
+   }
+   return true;
+}
+
+// Clear every cell and put them all on the free list
+void Playfield::clearGrid()
+{
+   freeCells.clear();
+   for (int cell = 0 ; cell < width * height ; cell++)
+   {
+      grid[cell] = CLEAR_VALUE;
+      freeIndex[cell] = cell;
+      freeCells.push_back(cell);
+   }
+}
+
+// Change the value of a cell and keep the free list in step.  A cell
+// leaves the list by swapping the last entry into its slot, so both
+// directions are constant time and never allocate.
+void Playfield::setCell(int cell, int value)
+{
+   bool wasFree = grid[cell] == CLEAR_VALUE;
+   bool isFree = value == CLEAR_VALUE;
+
+   grid[cell] = value;
+   if (wasFree && !isFree)
+   {
+      int slot = freeIndex[cell];
+      int last = freeCells.back();
+      freeCells[slot] = last;
+      freeIndex[last] = slot;
+      freeCells.pop_back();
+      freeIndex[cell] = -1;
    }
+   else if (!wasFree && isFree)
+   {
+      freeIndex[cell] = freeCells.size();
+      freeCells.push_back(cell);
+   }
+}
+
+// A uniformly chosen clear cell, or -1 if there are none
+int Playfield::randomFreeCell()
+{
+   if (freeCells.empty()) return -1;
+   return freeCells[rng.uniform(freeCells.size())];
 }
  
-const int *Playfield::getGrid() const { return grid ; }
+const GridCell *Playfield::getGrid() const { return grid ; }
 
-void Playfield::updatePlayfield()
+// Number of clear cells, kept current by setCell
+int Playfield::getFreeCellCount() const { return freeCells.size() ; }
+
+int Playfield::getWidth() const { return width ; }
+
+int Playfield::getHeight() const { return height ; }
+
+// Cells whose value changed during the last move: the old head (now tail),
+// the new head, a newly placed food and any tail segment that was freed
+const std::vector<int> &Playfield::getChangedCells() const
 {
-#ifdef GRAPHICS
-   DrawFilledRectangle(head, cellWidth, cellHeight, BLACK);
-   DrawFilledRectangle(food, cellWidth, cellHeight, RED);
+   return changedCells;
+}
 
-   if (tail.size() > 0)
-      DrawFilledRectangle(tail.back(), cellWidth, cellHeight, WHITE);
-#endif
+void Playfield::updatePlayfield()
+{
+   notify(head.first + head.second * width, CELL_HEAD);
+   if (food.first >= 0) notify(food.first + food.second * width, CELL_FOOD);
+   if (tailCount > 0)
+      notify(tail[(tailStart + tailCount - 1) % tail.size()], CELL_BODY);
 
-   while (tailLength < tail.size())
+   // Drop segments off the end of the tail until it is the right length
+   while (tailLength < tailCount)
    {
-      std::pair<int, int> segment = tail.front() ; tail.pop();
-      grid[segment.first + segment.second * PLAYFIELD_WIDTH] = CLEAR_VALUE;
-#ifdef GRAPHICS
-      DrawFilledRectangle(segment, cellWidth, cellHeight, GREEN);
-#endif
+      int cell = tail[tailStart];
+      tailStart = (tailStart + 1) % tail.size();
+      tailCount--;
+      setCell(cell, CLEAR_VALUE);
+      changedCells.push_back(cell);
+      notify(cell, CELL_CLEAR);
    }
+   updateView();
 }
 
+// Copy the current head, food and tail position into the view
+void Playfield::updateView()
+{
+   view.head = head.first + head.second * width;
+   view.food = (food.first < 0) ? -1 : food.first + food.second * width;
+   view.length = tailCount;
+   view.bodyStart = tailStart;
+   view.changed = changedCells.data();
+   view.changedCount = changedCells.size();
+}
+
+const PlayfieldView &Playfield::getView() const { return view; }
+
 std::pair<int, int> Playfield::translateHead(ValidMove move)
 {
    std::pair<int, int> newLocation = head;
@@ -127,39 +303,45 @@ std::pair<int, int> Playfield::translateHead(ValidMove move)
    return newLocation;
 }
 
+// Put the food on a random clear cell.  Sampling from the free list takes
+// the same time however full the board is.  If the snake fills the board
+// there is nowhere to put food and (-1, -1) is returned.
 std::pair<int, int> Playfield::placeNewFood()
 {
-   int x, y;
-   do 
-   {
-      x = rand() % PLAYFIELD_WIDTH;
-      y = rand() % PLAYFIELD_HEIGHT;
-   } while (grid[y * PLAYFIELD_WIDTH + x] != CLEAR_VALUE);
-   grid[x + y * PLAYFIELD_WIDTH] = FOOD_VALUE;
-   return std::pair<int, int>(x, y);
+   int cell = randomFreeCell();
+   if (cell < 0) return std::pair<int, int>(-1, -1);
+
+   setCell(cell, FOOD_VALUE);
+   return std::pair<int, int>(cell % width, cell / width);
 }
 
 int Playfield::getScore() const { return tailLength+1 ; }
 
+bool Playfield::outOfBounds(std::pair<int, int> cell) const
+{
+   return cell.first < 0 || cell.first >= width ||
+          cell.second < 0 || cell.second >= height;
+}
+
 bool Playfield::moveHead(ValidMove move)
 {
+   changedCells.clear();
+
    if (move == NONE) 
       return false;
 
    std::pair<int, int> newHeadPosition = translateHead(move);
 
    // Hit the border
-   if (OutOfBounds(newHeadPosition)) 
+   if (outOfBounds(newHeadPosition)) 
       return false;
 
    // Hit its tail
-   if (grid[newHeadPosition.first + newHeadPosition.second * PLAYFIELD_WIDTH] ==
+   if (grid[newHeadPosition.first + newHeadPosition.second * width] ==
        TAIL_VALUE)
    {
-#ifdef GRAPHICS
-      DrawFilledRectangle(newHeadPosition, cellWidth, cellHeight, ORANGE);
-      std::this_thread::sleep_for (std::chrono::seconds(5));
-#endif
+      notify(newHeadPosition.first + newHeadPosition.second * width,
+             CELL_CRASH);
       return false;
    }
 
@@ -167,11 +349,18 @@ bool Playfield::moveHead(ValidMove move)
    {
       tailLength++;
       food = placeNewFood();
+      if (food.first >= 0)
+         changedCells.push_back(food.first + food.second * width);
    }
 
-   tail.push(head);
-   grid[head.first + head.second * PLAYFIELD_WIDTH] = TAIL_VALUE;
+   int slot = (tailStart + tailCount) % tail.size();
+   tail[slot] = head.first + head.second * width;
+   tailCount++;
+   setCell(head.first + head.second * width, TAIL_VALUE);
+   changedCells.push_back(head.first + head.second * width);
    head = newHeadPosition;
-   grid[head.first + head.second * PLAYFIELD_WIDTH] = HEAD_VALUE;
+   setCell(head.first + head.second * width, HEAD_VALUE);
+   changedCells.push_back(head.first + head.second * width);
+   updateView();
    return true;
 }
@@ -4,61 +4,95 @@
 #ifndef PLAYFIELD_H
 #define PLAYFIELD_H
 #include <utility>
-#include <queue>
-#include <GL/freeglut.h>
+#include <vector>
 #include <string>
 #include <cstring>
 #include <cstdlib>
+#include <cstdint>
 #include <ctime>
-#include <thread>         // std::this_thread::sleep_for
-#include <chrono>         // std::chrono::seconds
 #include <unistd.h>
-#include "graphics.h"
 #include "biconnected.h"
-#include "cc.h"
+#include "rng.h"
+#include "gridCell.h"
+#include "playfieldView.h"
+#include "playfieldObserver.h"
 
 enum ValidMove {NONE, LEFT, RIGHT, UP, DOWN};
 
 const std::string MoveNames[] = {"None", "Left", "Right", "Up", "Down"};
 
+// Default board size
 #define PLAYFIELD_WIDTH 17
 #define PLAYFIELD_HEIGHT 15
-#define CLEAR_VALUE 0
-#define TAIL_VALUE 1
-#define HEAD_VALUE 2
-#define FOOD_VALUE 4
-#define OutOfBounds(x) ((x.first < 0 || x.first == PLAYFIELD_WIDTH ||\
-                         x.second < 0|| x.second == PLAYFIELD_HEIGHT))
+
+// Fraction of the cells that are obstacles when a playfield has them
+#define OBSTACLE_DENSITY 0.05
                     
+// The i-th body segment counting from the end of the tail (i = 0) towards
+// the head (i = length - 1)
+inline int bodyCell(const PlayfieldView &view, int i)
+{
+   int slot = view.bodyStart + i;
+   if (slot >= view.bodyCapacity) slot -= view.bodyCapacity;
+   return view.body[slot];
+}
+
 /********************************************************************//**
  * @class Playfield
  **********************************************************************/
 class Playfield
 {
+   int width;
+   int height;
    std::pair<int, int> head;
    std::pair<int, int> food;
-   std::queue<std::pair<int, int>> tail;
-   unsigned tailLength;
-   int cellWidth;
-   int cellHeight;
-   int *grid;
+   std::vector<int> tail;
+   int tailStart;
+   int tailCount;
+   int tailLength;
+   GridCell *grid;
    bool hasObstacles;
+   double obstacleDensity;
+   std::vector<int> changedCells;
+   std::vector<int> freeCells;
+   std::vector<int> freeIndex;
+   Rng rng;
+   PlayfieldView view;
+   PlayfieldObserver *observer;
 public:
    Playfield(bool placeObst = false);
+   Playfield(bool placeObst, uint64_t seed);
+   Playfield(int width, int height, bool placeObst, uint64_t seed,
+             double density = OBSTACLE_DENSITY);
    ~Playfield();
   
-   const int* getGrid() const;
+   const GridCell* getGrid() const;
+   int getFreeCellCount() const;
+   int getWidth() const;
+   int getHeight() const;
    int getScore() const;
+   const std::vector<int> &getChangedCells() const;
+   const PlayfieldView &getView() const;
+   void setObserver(PlayfieldObserver *);
 
 private:
    void draw();
    bool moveHead(ValidMove); 
    void updatePlayfield();
    std::pair<int, int> translateHead(ValidMove);
+   bool outOfBounds(std::pair<int, int>) const;
    std::pair<int, int> placeNewFood();
    void placeObstacles();
-   void drawObstacles();
+   bool ringIsOpen(int) const;
+   bool keepsNeighboursLinked(int) const;
+   void drawBoard();
+   void notify(int, CellState);
+   void clearGrid();
+   void setCell(int, int);
+   int randomFreeCell();
+   void updateView();
 
    friend class Game;
+   friend class ReplayFile;
 };
 #endif
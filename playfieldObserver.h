@@ -0,0 +1,28 @@
+/********************************************************************//**
+ * @file
+ ***********************************************************************/
+#ifndef PLAYFIELDOBSERVER_H
+#define PLAYFIELDOBSERVER_H
+
+// What a cell has just become
+enum CellState {CELL_CLEAR, CELL_OBSTACLE, CELL_HEAD, CELL_BODY, CELL_FOOD,
+                CELL_CRASH};
+
+/********************************************************************//**
+ * @class PlayfieldObserver
+ *
+ * Told about every cell a Playfield changes, in the order it changes
+ * them, so a frontend can draw the board without the simulation knowing
+ * how.  Cells are row-major indices.  CELL_CRASH is the cell the head
+ * hit when a move ends the game.  show() is called when the game is asked
+ * to draw itself, so an observer that batches changes can draw them all
+ * at once.
+ **********************************************************************/
+class PlayfieldObserver
+{
+public:
+   virtual void cellChanged(int cell, CellState state) = 0;
+   virtual void show() {}
+   virtual ~PlayfieldObserver() {}
+};
+#endif
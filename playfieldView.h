@@ -0,0 +1,40 @@
+/********************************************************************//**
+ * @file
+ *
+ * The game state a player sees.  This header is plain C so that player
+ * plugins can be written against it in any language with a C ABI.
+ ***********************************************************************/
+#ifndef PLAYFIELDVIEW_H
+#define PLAYFIELDVIEW_H
+#include "gridCell.h"
+
+/* What a grid cell holds; obstacles are stored as tail */
+#define CLEAR_VALUE 0
+#define TAIL_VALUE 1
+#define HEAD_VALUE 2
+#define FOOD_VALUE 4
+
+/********************************************************************//**
+ * @struct PlayfieldView
+ *
+ * Read-only picture of the game state kept up to date by the Playfield.
+ * The view lives inside the Playfield, so a pointer to it (and to the
+ * arrays it points at) stays valid for the life of the Playfield and
+ * always shows the current turn.  Cells are row-major indices.
+ **********************************************************************/
+typedef struct PlayfieldView
+{
+   int width;
+   int height;
+   int head;            /* cell of the head */
+   int food;            /* cell of the food, -1 if the board is full */
+   int length;          /* body segments behind the head */
+   const int *body;     /* ring buffer of body cells */
+   int bodyStart;       /* slot of the oldest segment, the end of the tail */
+   int bodyCapacity;    /* number of slots in the ring buffer */
+   const GridCell *grid;   /* the playfield grid, one byte per cell */
+   const int *changed;  /* cells that changed on the last move */
+   int changedCount;
+} PlayfieldView;
+
+#endif
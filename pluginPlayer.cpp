@@ -0,0 +1,74 @@
+/********************************************************************//**
+ * @file
+ ***********************************************************************/
+#include <dlfcn.h>
+#include "pluginPlayer.h"
+
+// Open a plugin and check that it was built against our interface
+PluginLibrary::PluginLibrary(const std::string &path)
+   : handle(NULL), plugin(NULL)
+{
+   // A bare name would be searched for on the library path, not here
+   std::string file = path.find('/') == std::string::npos ? "./" + path
+                                                          : path;
+   handle = dlopen(file.c_str(), RTLD_NOW | RTLD_LOCAL);
+   if (handle == NULL)
+   {
+      error = dlerror();
+      return;
+   }
+
+   typedef const PlayerPlugin *(*Entry)(void);
+   Entry entry = (Entry)dlsym(handle, PLAYER_PLUGIN_ENTRY);
+   if (entry == NULL)
+      error = path + ": no " PLAYER_PLUGIN_ENTRY "() entry point";
+   else if ((plugin = entry()) == NULL || plugin->abi != PLAYER_PLUGIN_ABI)
+   {
+      error = path + ": built for another plugin interface";
+      plugin = NULL;
+   }
+}
+
+PluginLibrary::~PluginLibrary()
+{
+   if (handle) dlclose(handle);
+}
+
+bool PluginLibrary::good() const
+{
+   return plugin != NULL;
+}
+
+const std::string &PluginLibrary::getError() const
+{
+   return error;
+}
+
+const char *PluginLibrary::getName() const
+{
+   return plugin ? plugin->name : "";
+}
+
+// A new player, or NULL if the plugin rejects the options
+Strategy *PluginLibrary::create(const std::string &options) const
+{
+   if (!plugin) return NULL;
+   void *player = plugin->create(options.c_str());
+   return player ? new PluginPlayer(plugin, player) : NULL;
+}
+
+PluginPlayer::PluginPlayer(const PlayerPlugin *plugin, void *player)
+   : plugin(plugin), player(player)
+{
+}
+
+PluginPlayer::~PluginPlayer()
+{
+   plugin->destroy(player);
+}
+
+ValidMove PluginPlayer::makeMove(const PlayfieldView &view)
+{
+   int move = plugin->makeMove(player, &view);
+   return move >= LEFT && move <= DOWN ? ValidMove(move) : NONE;
+}
@@ -0,0 +1,51 @@
+/********************************************************************//**
+ * @file
+ ***********************************************************************/
+#ifndef PLUGINPLAYER_H
+#define PLUGINPLAYER_H
+#include <string>
+#include "strategy.h"
+#include "playerPlugin.h"
+
+/********************************************************************//**
+ * @class PluginLibrary
+ *
+ * A player plugin opened with dlopen.  Each library is opened with its
+ * own symbols, so several plugins can export the same names.  The library
+ * stays loaded until the PluginLibrary is destroyed, so it must outlive
+ * every player it has created.
+ **********************************************************************/
+class PluginLibrary
+{
+   void *handle;
+   const PlayerPlugin *plugin;
+   std::string error;
+
+public:
+   PluginLibrary(const std::string &);
+   ~PluginLibrary();
+
+   bool good() const;
+   const std::string &getError() const;
+   const char *getName() const;
+   Strategy *create(const std::string &) const;
+};
+
+/********************************************************************//**
+ * @class PluginPlayer
+ *
+ * One player made by a plugin.  A move outside the ValidMove range is
+ * taken as giving up.
+ **********************************************************************/
+class PluginPlayer : public Strategy
+{
+   const PlayerPlugin *plugin;
+   void *player;
+
+public:
+   PluginPlayer(const PlayerPlugin *, void *);
+   ~PluginPlayer();
+
+   ValidMove makeMove(const PlayfieldView &);
+};
+#endif
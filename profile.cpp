@@ -0,0 +1,26 @@
+/********************************************************************//**
+ * @file
+ ***********************************************************************/
+#include "profile.h"
+
+// Each thread profiles its own game, so the active profile is per thread
+static thread_local TurnProfile *current = nullptr;
+
+void TurnProfile::clear()
+{
+   for (int p = 0 ; p < PHASE_COUNT ; p++)
+      seconds[p] = 0.0;
+   nodesExpanded = 0;
+   allocations = 0;
+}
+
+// The profile timers on this thread report to, or nullptr
+TurnProfile *activeProfile() { return current; }
+
+// Start reporting to profile; pass nullptr to stop profiling
+void setActiveProfile(TurnProfile *profile) { current = profile; }
+
+void profileNodes(long nodes)
+{
+   if (current) current->nodesExpanded += nodes;
+}
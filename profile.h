@@ -0,0 +1,69 @@
+/********************************************************************//**
+ * @file
+ *
+ * Per-turn phase timing.  Code that wants to be profiled wraps a phase in
+ * a PhaseTimer.  When a harness has installed a TurnProfile on the
+ * current thread with setActiveProfile, the elapsed steady_clock time is
+ * added to that phase; otherwise the timer does nothing and never reads
+ * the clock, so normal builds pay only a thread-local load.
+ ***********************************************************************/
+#ifndef PROFILE_H
+#define PROFILE_H
+#include <chrono>
+#include <string>
+
+enum ProfilePhase {PHASE_GRAPH, PHASE_SEARCH, PHASE_PATH, PHASE_SAFETY,
+                   PHASE_MOVE, PHASE_COUNT};
+
+const std::string PhaseNames[] = {"graph", "search", "path", "safety",
+                                  "move"};
+
+/********************************************************************//**
+ * @struct TurnProfile
+ *
+ * What happened during one turn
+ **********************************************************************/
+struct TurnProfile
+{
+   double seconds[PHASE_COUNT];  // time spent in each phase
+   long nodesExpanded;           // vertices taken off a search queue
+   long allocations;             // filled in by the harness, if it counts
+
+   void clear();
+};
+
+TurnProfile *activeProfile();
+void setActiveProfile(TurnProfile *);
+
+// Record expanded search nodes against the active profile, if any
+void profileNodes(long);
+
+/********************************************************************//**
+ * @class PhaseTimer
+ *
+ * Adds the time between construction and destruction to a phase of the
+ * active profile
+ **********************************************************************/
+class PhaseTimer
+{
+   ProfilePhase phase;
+   TurnProfile *profile;
+   std::chrono::steady_clock::time_point start;
+public:
+   PhaseTimer(ProfilePhase p) : phase(p), profile(activeProfile())
+   {
+      if (profile) start = std::chrono::steady_clock::now();
+   }
+
+   ~PhaseTimer() { stop(); }
+
+   // End the phase early; the destructor then records nothing more
+   void stop()
+   {
+      if (profile)
+         profile->seconds[phase] += std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+      profile = nullptr;
+   }
+};
+#endif
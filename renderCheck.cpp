@@ -0,0 +1,181 @@
+/********************************************************************//**
+ * @file
+ *
+ * Headless check of BoardRenderer.  Plays one seeded game with the
+ * renderer drawing into a framebuffer object of a surfaceless EGL
+ * context, so no window or display is needed, then reads the frame back
+ * and checks the fill and outline of every cell against the state the
+ * playfield last reported for it.  The exit status is 1 on any mismatch
+ * or if no context can be made.
+ ***********************************************************************/
+#define GL_GLEXT_PROTOTYPES
+#include <iostream>
+#include <cstdlib>
+#include <vector>
+#include <unistd.h>
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <GL/gl.h>
+#include <GL/glext.h>
+#include "boardRenderer.h"
+#include "graphics.h"
+#include "game.h"
+#include "player.h"
+
+using namespace std;
+
+#define FRAME_WIDTH 600
+#define FRAME_HEIGHT 600
+
+// What each CellState should look like: the fill, then the outline
+static const Color FillColors[] = {GREEN, BLUE, BLACK, WHITE, RED, ORANGE};
+static const Color EdgeColors[] = {GREEN, BLACK, BLACK, BLACK, BLACK, BLACK};
+
+// Keeps the last state reported for each cell and passes the changes on
+// to the renderer, since a playfield has one observer
+class StateRecorder : public PlayfieldObserver
+{
+   BoardRenderer *renderer;
+public:
+   vector<CellState> states;
+
+   StateRecorder(BoardRenderer *r, int cells)
+      : renderer(r), states(cells, CELL_CLEAR) {}
+
+   void cellChanged(int cell, CellState state)
+   {
+      states[cell] = state;
+      renderer->cellChanged(cell, state);
+   }
+
+   void show() { renderer->show(); }
+};
+
+// Make a GL context current with no surface, through the Mesa
+// surfaceless platform.  Returns false if the platform is missing.
+static bool makeContext()
+{
+   PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay =
+      (PFNEGLGETPLATFORMDISPLAYEXTPROC)
+      eglGetProcAddress("eglGetPlatformDisplayEXT");
+   if (!getPlatformDisplay) return false;
+
+   EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA,
+                                           EGL_DEFAULT_DISPLAY, NULL);
+   EGLint major, minor;
+   if (display == EGL_NO_DISPLAY || !eglInitialize(display, &major, &minor))
+      return false;
+
+   // The platform has no windows, so ask for a config that could back a
+   // pbuffer; the context is made current without one
+   EGLint attributes[] = {EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+                          EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE};
+   EGLConfig config;
+   EGLint configs;
+   if (!eglChooseConfig(display, attributes, &config, 1, &configs) ||
+       configs == 0 || !eglBindAPI(EGL_OPENGL_API))
+      return false;
+
+   EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT,
+                                         NULL);
+   return context != EGL_NO_CONTEXT &&
+          eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context);
+}
+
+// Whether the pixel at x, y is within one step of colour c
+static bool pixelIs(const vector<unsigned char> &frame, int x, int y,
+                    Color c)
+{
+   const unsigned char *p = &frame[(y * FRAME_WIDTH + x) * 3];
+   for (int i = 0 ; i < 3 ; i++)
+      if (abs(p[i] - (int)(Colors[c][i] * 255.0f + 0.5f)) > 1)
+         return false;
+   return true;
+}
+
+int main(int argc, char *argv[])
+{
+   uint64_t seed = 7;
+   int opt;
+
+   while ((opt = getopt(argc, argv, "s:")) != -1)
+   {
+      if (opt == 's') seed = strtoull(optarg, NULL, 10);
+      else
+      {
+         cerr << "Usage: " << argv[0] << " [-s seed]" << endl;
+         return 1;
+      }
+   }
+
+   if (!makeContext())
+   {
+      cerr << "Cannot make a surfaceless GL context" << endl;
+      return 1;
+   }
+
+   // Draw into a renderbuffer instead of a window
+   GLuint framebuffer, colorBuffer;
+   glGenFramebuffers(1, &framebuffer);
+   glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+   glGenRenderbuffers(1, &colorBuffer);
+   glBindRenderbuffer(GL_RENDERBUFFER, colorBuffer);
+   glRenderbufferStorage(GL_RENDERBUFFER, GL_RGB8, FRAME_WIDTH, FRAME_HEIGHT);
+   glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                             GL_RENDERBUFFER, colorBuffer);
+   if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+   {
+      cerr << "Framebuffer is not complete" << endl;
+      return 1;
+   }
+
+   // The projection the GLUT frontend sets on reshape
+   glViewport(0, 0, FRAME_WIDTH, FRAME_HEIGHT);
+   glMatrixMode(GL_PROJECTION);
+   glLoadIdentity();
+   glOrtho(0.0, FRAME_WIDTH, 0.0, FRAME_HEIGHT, -1.0, 1.0);
+   glMatrixMode(GL_MODELVIEW);
+   glLoadIdentity();
+
+   // Draw the board once at the start, so the final frame only uploads
+   // the colours the game changed
+   Playfield *playfield = new Playfield(true, seed);
+   int width = playfield->getWidth(), height = playfield->getHeight();
+   BoardRenderer renderer(width, height, FRAME_WIDTH, FRAME_HEIGHT);
+   StateRecorder recorder(&renderer, width * height);
+   playfield->setObserver(&recorder);
+   Game game(new Player(ASTAR), playfield);
+   game.draw();
+   while (!game.isGameOver())
+      game.makeMove();
+   game.draw();
+
+   vector<unsigned char> frame(FRAME_WIDTH * FRAME_HEIGHT * 3);
+   glPixelStorei(GL_PACK_ALIGNMENT, 1);
+   glReadPixels(0, 0, FRAME_WIDTH, FRAME_HEIGHT, GL_RGB, GL_UNSIGNED_BYTE,
+                frame.data());
+
+   // Check the middle of each cell and its lower left corner, which is
+   // on the outline
+   int cellWidth = FRAME_WIDTH / width, cellHeight = FRAME_HEIGHT / height;
+   int mismatches = 0;
+   for (int cell = 0 ; cell < width * height ; cell++)
+   {
+      CellState state = recorder.states[cell];
+      int x = cell % width * cellWidth, y = cell / width * cellHeight;
+      if (!pixelIs(frame, x + cellWidth / 2, y + cellHeight / 2,
+                   FillColors[state]) ||
+          !pixelIs(frame, x, y, EdgeColors[state]))
+      {
+         cerr << "Cell " << cell << " does not show state " << state << endl;
+         mismatches++;
+      }
+   }
+
+   cout << "Seed " << seed << ": score " << game.getScore() << ", "
+        << width * height - mismatches << " of " << width * height
+        << " cells drawn as reported" << endl;
+   glDeleteRenderbuffers(1, &colorBuffer);
+   glDeleteFramebuffers(1, &framebuffer);
+   return mismatches > 0 || glGetError() != GL_NO_ERROR;
+}
@@ -0,0 +1,97 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <unistd.h>
+#include "replayFile.h"
+
+using namespace std;
+using namespace std::chrono;
+
+static void usage(const char *name)
+{
+   cerr << "Usage: " << name << " [-s] file..." << endl;
+   cerr << "  -s only checks the records, without playing them again" << endl;
+}
+
+// Check every record of every replay file named, and play each game again
+// unless -s is given.  Damaged records and games that do not replay are
+// reported by file, record number and seed.  The exit status is 1 if
+// anything failed.
+int main(int argc, char *argv[])
+{
+   bool scanOnly = false;
+   int opt;
+
+   while ((opt = getopt(argc, argv, "s")) != -1)
+   {
+      switch (opt)
+      {
+         case 's': scanOnly = true; break;
+         default: usage(argv[0]); return 1;
+      }
+   }
+   if (optind >= argc) { usage(argv[0]); return 1; }
+
+   long records = 0, moves = 0, failures = 0;
+   size_t bytes = 0;
+   double scanSeconds = 0.0, verifySeconds = 0.0;
+   string error;
+
+   for (int f = optind ; f < argc ; f++)
+   {
+      ReplayFile file(argv[f]);
+      if (!file.good())
+      {
+         cerr << argv[f] << ": cannot read" << endl;
+         failures++;
+         continue;
+      }
+      bytes += file.bytes();
+
+      // Scan the whole file first, so its speed is measured on its own
+      vector<ReplayView> views;
+      ReplayView view;
+      steady_clock::time_point start = steady_clock::now();
+      while (!file.atEnd())
+      {
+         if (file.next(view, error))
+            views.push_back(view);
+         else if (!error.empty())
+         {
+            cerr << argv[f] << ": record " << views.size() << ": " << error
+                 << endl;
+            failures++;
+         }
+      }
+      scanSeconds += duration<double>(steady_clock::now() - start).count();
+      records += views.size();
+      if (scanOnly) continue;
+
+      start = steady_clock::now();
+      for (size_t i = 0 ; i < views.size() ; i++)
+      {
+         moves += views[i].header->moveCount;
+         if (!ReplayFile::verify(views[i], error))
+         {
+            cerr << argv[f] << ": record " << i << " (seed "
+                 << views[i].header->seed << "): " << error << endl;
+            failures++;
+         }
+      }
+      verifySeconds += duration<double>(steady_clock::now() - start).count();
+   }
+
+   cout << fixed << setprecision(2);
+   cout << "Records: " << records << " in " << bytes << " bytes ("
+        << (records ? (double)bytes / records : 0.0) << " bytes each)"
+        << endl;
+   cout << "Scan: " << scanSeconds << " s (" << bytes / scanSeconds / 1e6
+        << " MB/s)" << endl;
+   if (!scanOnly)
+      cout << "Replay: " << verifySeconds << " s (" << records / verifySeconds
+           << " games/s, " << moves / verifySeconds << " moves/s)" << endl;
+   cout << "Failures: " << failures << endl;
+
+   return failures ? 1 : 0;
+}
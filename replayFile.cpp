@@ -0,0 +1,224 @@
+/********************************************************************//**
+ * @file
+ ***********************************************************************/
+#include "replayFile.h"
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Records start on multiples of this many bytes
+#define REPLAY_ALIGN 8
+
+static size_t padded(size_t n)
+{
+   return (n + REPLAY_ALIGN - 1) & ~(size_t)(REPLAY_ALIGN - 1);
+}
+
+// Bytes of bitmap and of move stream in a record
+static size_t bitmapSize(const ReplayHeader &h)
+{
+   return ((size_t)h.width * h.height + 7) / 8;
+}
+
+static size_t storedMoves(const ReplayHeader &h)
+{
+   return h.moveCount - ((h.flags & REPLAY_GAVE_UP) ? 1 : 0);
+}
+
+size_t replayBodySize(const ReplayHeader &h)
+{
+   return bitmapSize(h) + (storedMoves(h) + 3) / 4;
+}
+
+// FNV-1a over 64-bit words, folded to 32 bits.  Working a word at a time
+// keeps a scan of the file well ahead of the disk.
+uint32_t replayChecksum(const uint8_t *bytes, size_t n)
+{
+   uint64_t hash = 14695981039346656037ULL;
+   size_t i = 0;
+   for ( ; i + 8 <= n ; i += 8)
+   {
+      uint64_t word;
+      memcpy(&word, bytes + i, 8);
+      hash = (hash ^ word) * 1099511628211ULL;
+   }
+   for ( ; i < n ; i++)
+      hash = (hash ^ bytes[i]) * 1099511628211ULL;
+   return (uint32_t)(hash ^ (hash >> 32));
+}
+
+ReplayRecorder::ReplayRecorder(uint64_t seed, bool obst, double density)
+   : stored(0)
+{
+   memset(&header, 0, sizeof header);
+   header.magic = REPLAY_MAGIC;
+   header.version = REPLAY_VERSION;
+   header.flags = obst ? REPLAY_OBSTACLES : 0;
+   header.seed = seed;
+   header.density = density;
+}
+
+// Take the size and the obstacles of a new playfield.  Before the first
+// move the only body cells on the board are obstacles.
+void ReplayRecorder::begin(const Playfield *playfield)
+{
+   header.width = playfield->getWidth();
+   header.height = playfield->getHeight();
+   header.moveCount = 0;
+   header.flags &= REPLAY_OBSTACLES;
+   stored = 0;
+
+   obstacles.assign(bitmapSize(header), 0);
+   const GridCell *grid = playfield->getGrid();
+   for (int cell = 0 ; cell < header.width * header.height ; cell++)
+      if (grid[cell] == TAIL_VALUE)
+         obstacles[cell >> 3] |= 1 << (cell & 7);
+
+   moves.clear();
+   moves.reserve(header.width * header.height / 4);
+}
+
+// Add a move.  NONE can only be a player's last move, so it is kept as a
+// flag rather than taking a third bit for every move.
+void ReplayRecorder::record(ValidMove move)
+{
+   header.moveCount++;
+   if (move == NONE)
+   {
+      header.flags |= REPLAY_GAVE_UP;
+      return;
+   }
+   if ((stored & 3) == 0) moves.push_back(0);
+   moves.back() |= (move - LEFT) << ((stored & 3) * 2);
+   stored++;
+}
+
+// Mark the game over with its final score
+void ReplayRecorder::finish(int score)
+{
+   header.flags |= REPLAY_FINISHED;
+   header.score = score;
+}
+
+// Write the record to the end of out
+void ReplayRecorder::append(std::string &out) const
+{
+   size_t start = out.size();
+   size_t body = obstacles.size() + moves.size();
+   out.resize(start + padded(sizeof header + body), 0);
+
+   char *p = &out[start];
+   memcpy(p + sizeof header, obstacles.data(), obstacles.size());
+   memcpy(p + sizeof header + obstacles.size(), moves.data(), moves.size());
+
+   ReplayHeader h = header;
+   h.checksum = replayChecksum((const uint8_t *)p + sizeof header, body);
+   memcpy(p, &h, sizeof h);
+}
+
+// Map a whole file.  An empty or unreadable file gives a ReplayFile that
+// is not good and has no records.
+ReplayFile::ReplayFile(const std::string &path)
+   : fd(open(path.c_str(), O_RDONLY)), data(NULL), size(0), offset(0)
+{
+   struct stat st;
+   if (fd < 0 || fstat(fd, &st) != 0 || st.st_size == 0) return;
+
+   void *map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+   if (map == MAP_FAILED) return;
+   madvise(map, st.st_size, MADV_SEQUENTIAL);
+   data = (const uint8_t *)map;
+   size = st.st_size;
+}
+
+ReplayFile::~ReplayFile()
+{
+   if (data) munmap((void *)data, size);
+   if (fd >= 0) close(fd);
+}
+
+bool ReplayFile::good() const { return data != NULL; }
+
+size_t ReplayFile::bytes() const { return size; }
+
+bool ReplayFile::atEnd() const { return offset >= size; }
+
+void ReplayFile::rewind() { offset = 0; }
+
+// Point view at the next record and check it.  Returns false at the end
+// of the file, or with error set if the record is damaged; nothing after a
+// damaged record can be found, so the file is then at its end.
+bool ReplayFile::next(ReplayView &view, std::string &error)
+{
+   error.clear();
+   if (atEnd()) return false;
+
+   const ReplayHeader *h = (const ReplayHeader *)(data + offset);
+   if (size - offset < sizeof *h || h->magic != REPLAY_MAGIC ||
+       h->version != REPLAY_VERSION)
+      error = "not a replay record";
+   else if (h->width < 2 || h->height < 2 ||
+            (h->moveCount == 0 && (h->flags & REPLAY_GAVE_UP)))
+      error = "bad header";
+   else if (size - offset - sizeof *h < replayBodySize(*h))
+      error = "record runs past the end of the file";
+
+   if (!error.empty())
+   {
+      offset = size;
+      return false;
+   }
+
+   view.header = h;
+   view.obstacles = data + offset + sizeof *h;
+   view.moves = view.obstacles + bitmapSize(*h);
+   offset += padded(sizeof *h + replayBodySize(*h));
+
+   if (replayChecksum(view.obstacles, replayBodySize(*h)) != h->checksum)
+      error = "checksum mismatch";
+   return error.empty();
+}
+
+// Rebuild the playfield from the seed and play every move again.  The
+// obstacles must match the bitmap, every move but a finished game's last
+// must be legal, and a finished game must end on its last move with the
+// recorded score.
+bool ReplayFile::verify(const ReplayView &view, std::string &error)
+{
+   const ReplayHeader &h = *view.header;
+   Playfield playfield(h.width, h.height, h.flags & REPLAY_OBSTACLES,
+                       h.seed, h.density);
+
+   const GridCell *grid = playfield.getGrid();
+   for (int cell = 0 ; cell < h.width * h.height ; cell++)
+      if ((grid[cell] == TAIL_VALUE) != view.obstacle(cell))
+      {
+         error = "obstacles differ at cell " + std::to_string(cell);
+         return false;
+      }
+
+   bool finished = h.flags & REPLAY_FINISHED;
+   for (uint32_t i = 0 ; i < h.moveCount ; i++)
+   {
+      bool last = (i == h.moveCount - 1);
+      bool alive = playfield.moveHead(view.move(i));
+      playfield.updatePlayfield();
+      if (alive != !(last && finished))
+      {
+         error = "move " + std::to_string(i) + " " +
+                 MoveNames[view.move(i)] +
+                 (alive ? " should have ended the game" : " is illegal");
+         return false;
+      }
+   }
+
+   if (finished && playfield.getScore() != h.score)
+   {
+      error = "score " + std::to_string(playfield.getScore()) +
+              " instead of " + std::to_string(h.score);
+      return false;
+   }
+   return true;
+}
@@ -0,0 +1,133 @@
+/********************************************************************//**
+ * @file
+ *
+ * Compact game replays.  A playfield is fully determined by its size,
+ * obstacle settings and seed, so a replay only stores those and the moves:
+ * two bits per move.  A file is any number of records back to back, each
+ *
+ *    ReplayHeader
+ *    obstacle bitmap, one bit per cell, row-major
+ *    move stream, four moves per byte, first move in the low bits
+ *    padding to a multiple of 8 bytes
+ *
+ * A typical 17x15 game of 500 moves takes about 200 bytes.  The header
+ * checksum covers the bitmap and the moves, so a file can be checked
+ * without replaying it.  Records are written as they are laid out in
+ * memory (little-endian on the machines we use).
+ ***********************************************************************/
+#ifndef REPLAYFILE_H
+#define REPLAYFILE_H
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "playfield.h"
+
+#define REPLAY_MAGIC 0x524b4e53        // "SNKR"
+#define REPLAY_VERSION 1
+
+// ReplayHeader flags
+#define REPLAY_OBSTACLES 1    // the playfield was built with obstacles
+#define REPLAY_GAVE_UP 2      // the last move was NONE and is not stored
+#define REPLAY_FINISHED 4     // the last move ended the game
+
+/********************************************************************//**
+ * @struct ReplayHeader
+ *
+ * Start of one replay record
+ **********************************************************************/
+struct ReplayHeader
+{
+   uint32_t magic;
+   uint16_t version;
+   uint16_t flags;
+   int32_t width;
+   int32_t height;
+   uint64_t seed;
+   double density;
+   uint32_t moveCount;     // moves made, including a final NONE
+   int32_t score;          // final score, if the game finished
+   uint32_t checksum;      // of the bitmap and the move stream
+   uint32_t reserved;
+};
+
+// Bytes taken by the bitmap and the moves of a record
+size_t replayBodySize(const ReplayHeader &);
+
+// Checksum of n bytes, eight at a time
+uint32_t replayChecksum(const uint8_t *, size_t);
+
+/********************************************************************//**
+ * @class ReplayRecorder
+ *
+ * Builds the replay of one game as it is played.  Game::setReplay calls
+ * begin with the new playfield and Game::makeMove records each move.
+ **********************************************************************/
+class ReplayRecorder
+{
+   ReplayHeader header;
+   std::vector<uint8_t> obstacles;
+   std::vector<uint8_t> moves;
+   uint32_t stored;
+
+public:
+   ReplayRecorder(uint64_t seed, bool obstacles,
+                  double density = OBSTACLE_DENSITY);
+
+   void begin(const Playfield *);
+   void record(ValidMove);
+   void finish(int);
+   void append(std::string &) const;
+};
+
+/********************************************************************//**
+ * @struct ReplayView
+ *
+ * One record inside a mapped file
+ **********************************************************************/
+struct ReplayView
+{
+   const ReplayHeader *header;
+   const uint8_t *obstacles;
+   const uint8_t *moves;
+
+   bool obstacle(int cell) const
+   {
+      return obstacles[cell >> 3] >> (cell & 7) & 1;
+   }
+
+   ValidMove move(uint32_t i) const
+   {
+      if ((header->flags & REPLAY_GAVE_UP) && i == header->moveCount - 1)
+         return NONE;
+      return ValidMove((moves[i >> 2] >> ((i & 3) * 2) & 3) + LEFT);
+   }
+};
+
+/********************************************************************//**
+ * @class ReplayFile
+ *
+ * A replay file mapped read-only into memory.  next() walks the records
+ * and checks each header and checksum, which touches every byte once and
+ * copies nothing; verify() replays a record through a Playfield.
+ **********************************************************************/
+class ReplayFile
+{
+   int fd;
+   const uint8_t *data;
+   size_t size;
+   size_t offset;
+
+public:
+   ReplayFile(const std::string &);
+   ~ReplayFile();
+
+   bool good() const;
+   size_t bytes() const;
+   bool atEnd() const;
+   void rewind();
+   bool next(ReplayView &, std::string &);
+
+   static bool verify(const ReplayView &, std::string &);
+};
+#endif
@@ -0,0 +1,66 @@
+/********************************************************************//**
+ * @file
+ ***********************************************************************/
+#include "rng.h"
+
+static inline uint64_t rotl(uint64_t x, int k)
+{
+   return (x << k) | (x >> (64 - k));
+}
+
+// SplitMix64 step, used to spread a single seed over the 256 bit state
+static uint64_t splitMix(uint64_t &x)
+{
+   uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+   z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+   z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+   return z ^ (z >> 31);
+}
+
+Rng::Rng(uint64_t value) { seed(value); }
+
+// Restart the sequence from a seed.  Nearby seeds give unrelated
+// sequences, so seed + i is fine for a batch of games.
+void Rng::seed(uint64_t value)
+{
+   for (int i = 0 ; i < 4 ; i++)
+      s[i] = splitMix(value);
+}
+
+// Next 64 random bits
+uint64_t Rng::next()
+{
+   const uint64_t result = rotl(s[1] * 5, 7) * 9;
+   const uint64_t t = s[1] << 17;
+
+   s[2] ^= s[0];
+   s[3] ^= s[1];
+   s[1] ^= s[2];
+   s[0] ^= s[3];
+   s[2] ^= t;
+   s[3] = rotl(s[3], 45);
+
+   return result;
+}
+
+// Uniform integer in [0, n) using Lemire's multiply-and-reject method,
+// which is unbiased and almost never needs a second draw
+int Rng::uniform(int n)
+{
+   uint64_t range = (uint64_t)n;
+   uint64_t x = next() >> 32;
+   uint64_t m = x * range;
+   uint32_t low = (uint32_t)m;
+
+   if (low < range)
+   {
+      uint32_t threshold = (uint32_t)(-(uint32_t)range) % (uint32_t)range;
+      while (low < threshold)
+      {
+         x = next() >> 32;
+         m = x * range;
+         low = (uint32_t)m;
+      }
+   }
+   return (int)(m >> 32);
+}
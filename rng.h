@@ -0,0 +1,25 @@
+/********************************************************************//**
+ * @file
+ ***********************************************************************/
+#ifndef RNG_H
+#define RNG_H
+#include <cstdint>
+
+/********************************************************************//**
+ * @class Rng
+ *
+ * A small, fast xoshiro256** pseudo-random generator.  Every instance
+ * has its own state, so generators on different threads never contend,
+ * and the same seed always produces the same sequence.
+ **********************************************************************/
+class Rng
+{
+   uint64_t s[4];
+public:
+   Rng(uint64_t seed = 0);
+
+   void seed(uint64_t);
+   uint64_t next();
+   int uniform(int n);
+};
+#endif
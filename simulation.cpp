@@ -0,0 +1,97 @@
+/********************************************************************//**
+ * @file
+ ***********************************************************************/
+#include "simulation.h"
+#include <chrono>
+
+// Shown cells start as this, which is no CellState, so the first frame
+// draws every cell
+#define NOT_SHOWN 0xff
+
+// Set up the game and the first frame.  The thread is not started until
+// start(), so the frontend can draw the board before the first move.
+Simulation::Simulation(Strategy *player, Playfield *pf, int msec, int moves)
+   : game(new Game(player, pf)), playfield(pf), tickMsec(msec),
+     movesPerTick(moves > 0 ? moves : 1),
+     cells(pf->getWidth() * pf->getHeight(), CELL_CLEAR),
+     shown(cells.size(), NOT_SHOWN), stopping(false)
+{
+   for (int i = 0 ; i < 3 ; i++)
+      frames.slot(i).cells.reserve(cells.size());
+   playfield->setObserver(this);
+   publish();
+   frames.update();
+}
+
+// Stop the game thread, if it is still playing, and delete the game
+Simulation::~Simulation()
+{
+   stopping.store(true, std::memory_order_relaxed);
+   if (thread.joinable()) thread.join();
+   delete game;
+}
+
+void Simulation::start()
+{
+   thread = std::thread(&Simulation::run, this);
+}
+
+// Game thread: play until the game ends or the simulation is stopped,
+// publishing the board after every move
+void Simulation::run()
+{
+   std::chrono::steady_clock::time_point next =
+      std::chrono::steady_clock::now();
+
+   while (!game->isGameOver() && !stopping.load(std::memory_order_relaxed))
+   {
+      for (int i = 0 ; i < movesPerTick && !game->isGameOver() ; i++)
+      {
+         game->makeMove();
+         publish();
+      }
+      if (tickMsec > 0)
+      {
+         next += std::chrono::milliseconds(tickMsec);
+         std::this_thread::sleep_until(next);
+      }
+   }
+}
+
+// Game thread: copy the board into the back frame and publish it.  The
+// frames keep their storage, so this does not allocate.
+void Simulation::publish()
+{
+   BoardFrame &frame = frames.writeSlot();
+   frame.cells.assign(cells.begin(), cells.end());
+   frame.score = game->getScore();
+   frame.gameOver = game->isGameOver();
+   frames.publish();
+}
+
+// Game thread: keep the board up to date as the playfield changes
+void Simulation::cellChanged(int cell, CellState state)
+{
+   cells[cell] = state;
+}
+
+// Frontend: give renderer the cells that changed since the frame it was
+// last given, then have it draw
+void Simulation::show(PlayfieldObserver *renderer)
+{
+   frames.update();
+   const std::vector<uint8_t> &now = frames.readSlot().cells;
+   for (size_t cell = 0 ; cell < now.size() ; cell++)
+      if (now[cell] != shown[cell])
+      {
+         renderer->cellChanged(cell, CellState(now[cell]));
+         shown[cell] = now[cell];
+      }
+   renderer->show();
+}
+
+// Frontend: whether the frame last shown is the end of the game
+bool Simulation::isGameOver() const { return frames.readSlot().gameOver; }
+
+// Frontend: the score in the frame last shown
+int Simulation::getScore() const { return frames.readSlot().score; }
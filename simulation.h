@@ -0,0 +1,67 @@
+/********************************************************************//**
+ * @file
+ ***********************************************************************/
+#ifndef SIMULATION_H
+#define SIMULATION_H
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "game.h"
+#include "tripleBuffer.h"
+
+/********************************************************************//**
+ * @struct BoardFrame
+ *
+ * The board after one move, as the frontend draws it: a CellState per
+ * cell plus what goes in the window title
+ **********************************************************************/
+struct BoardFrame
+{
+   std::vector<uint8_t> cells;
+   int score;
+   bool gameOver;
+};
+
+/********************************************************************//**
+ * @class Simulation
+ *
+ * Plays a game on its own thread and publishes a BoardFrame after every
+ * move through a TripleBuffer.  The frontend calls show() whenever it
+ * draws; it picks up the newest frame, passes the cells that differ from
+ * the last frame it showed to a renderer and never waits on the game.  A
+ * slow move therefore never holds up a frame, and a slow frame never
+ * holds up a move.
+ *
+ * The game plays movesPerTick moves every tickMsec milliseconds, or as
+ * fast as it can when tickMsec is 0.  Everything but the constructor,
+ * start and the destructor is for the frontend thread only.
+ **********************************************************************/
+class Simulation : public PlayfieldObserver
+{
+   Game *game;
+   Playfield *playfield;
+   int tickMsec;
+   int movesPerTick;
+   std::vector<uint8_t> cells;   // the board now, kept by cellChanged
+   TripleBuffer<BoardFrame> frames;
+   std::vector<uint8_t> shown;   // the board the renderer was last given
+   std::atomic<bool> stopping;
+   std::thread thread;
+
+public:
+   Simulation(Strategy *, Playfield *, int tickMsec, int movesPerTick = 1);
+   ~Simulation();
+
+   void start();
+   void show(PlayfieldObserver *);
+   bool isGameOver() const;
+   int getScore() const;
+
+   void cellChanged(int, CellState);
+
+private:
+   void run();
+   void publish();
+};
+#endif
@@ -11,40 +11,42 @@
 #define canEnter(r,c) (validRow(r) && validCol(c) && \
                       (grid[(r)*width+c] != INVALID_VALUE))
 
-SnakeGraph::SnakeGraph() { } // for the derived types
+SnakeGraph::SnakeGraph() : offsets(1, 0), numVertices(0), numEdges(0) { }
 
 // Convert a 2d array (height x width) into a graph
 // This constructor assumes the graph is undirected and
 // unweighted
-SnakeGraph::SnakeGraph(const int *grid, int width, int height)
+SnakeGraph::SnakeGraph(const GridCell *grid, int width, int height)
 {
+   offsets.resize(height * width + 1);
+   targets.reserve(4 * height * width);
+   vertexList.reserve(height * width);
+
    for (int index = 0 ; index < height * width ; index++)
    {
       int row = index / width;
       int col = index % width;
+      offsets[index] = targets.size();
 
       // The canEnter macro decides if a cell can originate and edge
       if (!canEnter(row, col)) continue;
 
       // Make sure that valid cells will show up in the vertex list
       // These cells may not have any edges incident
-      if (vertices.find(index) == vertices.end())
-         vertices[index] = set<int>{};
+      vertexList.push_back(index);
 
       // The grid represents a graph with possible edges in the four
-      // cardinal directions {UP, DOWN, RIGHT, LEFT}  
-      if (canEnter(row-1, col)) addEdge(index, index-width);
-      if (canEnter(row+1, col)) addEdge(index, index+width);
-      if (canEnter(row, col+1)) addEdge(index, index+1);
-      if (canEnter(row, col-1)) addEdge(index, index-1);
+      // cardinal directions {UP, DOWN, RIGHT, LEFT}.  Each edge is
+      // seen from both ends, so both directions get stored.
+      if (canEnter(row-1, col)) targets.push_back(index-width);
+      if (canEnter(row+1, col)) targets.push_back(index+width);
+      if (canEnter(row, col+1)) targets.push_back(index+1);
+      if (canEnter(row, col-1)) targets.push_back(index-1);
    }
+   offsets[height * width] = targets.size();
 
-   numVertices = vertices.size();
-   numEdges = 0;
-   for (int v : Vertices())
-      numEdges += adj(v).size();
-
-   numEdges /= 2;
+   numVertices = vertexList.size();
+   numEdges = targets.size() / 2;
 }
 
 // Return the number of vertices in the graph
@@ -53,26 +55,17 @@ int SnakeGraph::V() const { return numVertices ; }
 // Return the number of edges in the graph
 int SnakeGraph::E() const { return numEdges ; }
 
-// Return the set of vertices in the graph
-// Since we are returning a set, the vertices will
-// be ordered
-set<int> SnakeGraph::Vertices() const
-{
-   set<int> retVal;
-   for (auto &kv : vertices)
-      retVal.insert(kv.first);
- 
-   return retVal;
-}
-
-// Return the adjacency set for the vertex v
-set<int> SnakeGraph::adj(int v)
+// Return the vertices in the graph, in increasing order
+VertexRange SnakeGraph::Vertices() const
 {
-   return vertices[v];
+   return VertexRange(vertexList.data(), vertexList.data() + numVertices);
 }
 
-void SnakeGraph::addEdge(int v, int w)
+// Return the neighbours of the vertex v, none if v is not a vertex
+VertexRange SnakeGraph::adj(int v) const
 {
-   vertices[v].insert(w);
-   vertices[w].insert(v);
+   if (v < 0 || v + 1 >= (int)offsets.size())
+      return VertexRange(nullptr, nullptr);
+   return VertexRange(targets.data() + offsets[v],
+                      targets.data() + offsets[v + 1]);
 }
@@ -1,33 +1,44 @@
 #ifndef SNAKEGRAPH_H
 #define SNAKEGRAPH_H
-#include <map>
-#include <set>
-#include <string>
-#include <fstream>
+#include <vector>
+#include "gridCell.h"
+#include "vertexRange.h"
+#include "gridGraph.h"
 
 using namespace std;
 
-typedef map<int, set<int> > snakeMap_t;
-
 // This is the Graph API we have talked about.  The name of
 // the class is changed so that it does not conflict with
 // student code
+//
+// The neighbours of every vertex are kept in one array, in compressed
+// sparse row form like WeightedGraph, so adj() and Vertices() return
+// views instead of copies.  It models the grid graph concept of
+// gridGraph.h, with every step costing 1.
 class SnakeGraph
 {
-   snakeMap_t vertices;
-
-protected:
+   vector<int> offsets;      // neighbours of v are targets[offsets[v]..]
+   vector<int> targets;
+   vector<int> vertexList;   // in increasing order
    int numVertices, numEdges;
 
 public:
    SnakeGraph();
-   SnakeGraph(const int *, int, int);
+   SnakeGraph(const GridCell *, int, int);
 
-   set<int> Vertices() const;
-   set<int> adj(int v);
-   virtual void addEdge(int, int);
+   VertexRange Vertices() const;
+   VertexRange adj(int v) const;
    int V() const;
    int E() const;
+
+   // The grid graph concept
+   int cells() const { return offsets.size() - 1; }
+   int cost(int) const { return 1; }
+   int neighbour(int v, int k) const
+   {
+      int i = offsets[v] + k;
+      return i < offsets[v + 1] ? targets[i] : NO_NEIGHBOUR;
+   }
 };
 
 #endif
@@ -0,0 +1,79 @@
+/********************************************************************//**
+ * @file
+ ***********************************************************************/
+#ifndef SPSCRING_H
+#define SPSCRING_H
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+// Bytes between the producer's and the consumer's counters, so the two
+// threads do not write to the same cache line
+#define CACHE_LINE 64
+
+/********************************************************************//**
+ * @class SpscRing
+ *
+ * A bounded queue for exactly one producer thread and one consumer
+ * thread.  Neither side locks or allocates: the slots are allocated once,
+ * the producer only writes the tail counter and the consumer only writes
+ * the head counter.  The capacity is rounded up to a power of two so a
+ * counter becomes a slot with a mask.  A full ring refuses new items
+ * rather than waiting for the consumer.
+ **********************************************************************/
+template<class T>
+class SpscRing
+{
+   std::vector<T> slots;
+   size_t mask;
+   char pad0[CACHE_LINE];
+   std::atomic<size_t> head;     // next slot to read, written by the consumer
+   char pad1[CACHE_LINE];
+   std::atomic<size_t> tail;     // next slot to write, written by the producer
+   char pad2[CACHE_LINE];
+
+public:
+   SpscRing(size_t capacity) : head(0), tail(0)
+   {
+      size_t size = 1;
+      while (size < capacity) size <<= 1;
+      slots.resize(size);
+      mask = size - 1;
+   }
+
+   // Producer: add an item, or return false if the ring is full
+   bool push(const T &item)
+   {
+      size_t t = tail.load(std::memory_order_relaxed);
+      if (t - head.load(std::memory_order_acquire) > mask) return false;
+      slots[t & mask] = item;
+      tail.store(t + 1, std::memory_order_release);
+      return true;
+   }
+
+   // Consumer: take the oldest item, or return false if the ring is empty
+   bool pop(T &item)
+   {
+      size_t h = head.load(std::memory_order_relaxed);
+      if (h == tail.load(std::memory_order_acquire)) return false;
+      item = slots[h & mask];
+      head.store(h + 1, std::memory_order_release);
+      return true;
+   }
+
+   // Consumer: take up to max items into out, oldest first, and return how
+   // many were taken.  One pair of atomic operations covers the batch.
+   size_t popBatch(T *out, size_t max)
+   {
+      size_t h = head.load(std::memory_order_relaxed);
+      size_t available = tail.load(std::memory_order_acquire) - h;
+      size_t n = available < max ? available : max;
+      for (size_t i = 0 ; i < n ; i++)
+         out[i] = slots[(h + i) & mask];
+      head.store(h + n, std::memory_order_release);
+      return n;
+   }
+
+   size_t capacity() const { return mask + 1; }
+};
+#endif
@@ -0,0 +1,21 @@
+/********************************************************************//**
+ * @file
+ ***********************************************************************/
+#ifndef STRATEGY_H
+#define STRATEGY_H
+#include "playfield.h"
+
+/********************************************************************//**
+ * @class Strategy
+ *
+ * Anything that can choose the snake's moves.  The built-in Player is
+ * one; PluginPlayer runs one loaded from a shared library.  A Game owns
+ * its strategy and deletes it.
+ **********************************************************************/
+class Strategy
+{
+public:
+   virtual ValidMove makeMove(const PlayfieldView &) = 0;
+   virtual ~Strategy() {}
+};
+#endif
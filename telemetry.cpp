@@ -0,0 +1,70 @@
+/********************************************************************//**
+ * @file
+ ***********************************************************************/
+#include "telemetry.h"
+#include <chrono>
+
+// Records written to the file per fwrite
+#define TELEMETRY_BATCH 256
+
+// Open the file, write its header and start the consumer.  If the file
+// cannot be opened no thread is started and every record is dropped.
+TelemetryLog::TelemetryLog(const std::string &path, int width, int height,
+                           size_t capacity)
+   : ring(capacity), file(fopen(path.c_str(), "wb")), stopping(false),
+     dropped(0)
+{
+   if (!file) return;
+
+   TelemetryHeader header = {TELEMETRY_MAGIC, TELEMETRY_VERSION,
+                             sizeof(TickRecord), width, height};
+   fwrite(&header, sizeof header, 1, file);
+   consumer = std::thread(&TelemetryLog::drain, this);
+}
+
+// Stop the consumer once the ring is empty, and close the file
+TelemetryLog::~TelemetryLog()
+{
+   stopping.store(true, std::memory_order_release);
+   if (consumer.joinable()) consumer.join();
+   if (file) fclose(file);
+}
+
+// Whether the file was opened
+bool TelemetryLog::good() const { return file != NULL; }
+
+// Queue a record for the file.  Returns false, and counts the record as
+// dropped, if the ring is full or there is no file.
+bool TelemetryLog::publish(const TickRecord &record)
+{
+   if (file && ring.push(record)) return true;
+   dropped.fetch_add(1, std::memory_order_relaxed);
+   return false;
+}
+
+// Records that did not make it into the ring
+long TelemetryLog::droppedCount() const
+{
+   return dropped.load(std::memory_order_relaxed);
+}
+
+// Consumer thread: copy records from the ring to the file in batches.
+// When the ring is empty it sleeps briefly rather than wait on a
+// condition variable, which would make the producer take a lock to
+// signal it.  The stop flag is read before the ring, so records published
+// before the destructor ran are always written.
+void TelemetryLog::drain()
+{
+   TickRecord batch[TELEMETRY_BATCH];
+
+   while (true)
+   {
+      bool last = stopping.load(std::memory_order_acquire);
+      size_t n;
+      while ((n = ring.popBatch(batch, TELEMETRY_BATCH)) > 0)
+         fwrite(batch, sizeof(TickRecord), n, file);
+      if (last) break;
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+   }
+   fflush(file);
+}
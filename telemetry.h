@@ -0,0 +1,87 @@
+/********************************************************************//**
+ * @file
+ *
+ * Per-tick game telemetry.  The game thread publishes one TickRecord per
+ * move into a lock-free ring; a consumer thread owned by the TelemetryLog
+ * drains the ring to a binary file.  Publishing copies 24 bytes and never
+ * locks, allocates or waits.  If the consumer falls behind the record is
+ * dropped and counted instead of slowing the game down.
+ *
+ * The file is a TelemetryHeader followed by TickRecords, both written
+ * as they are laid out in memory (little-endian on the machines we use).
+ ***********************************************************************/
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include "spscRing.h"
+
+#define TELEMETRY_MAGIC 0x544b4e53     // "SNKT"
+#define TELEMETRY_VERSION 1
+
+// Records the ring holds before the game thread starts dropping them
+#define TELEMETRY_CAPACITY 4096
+
+/********************************************************************//**
+ * @struct TelemetryHeader
+ *
+ * Start of a telemetry file.  Cells in the records are row-major indices
+ * into a width x height board.
+ **********************************************************************/
+struct TelemetryHeader
+{
+   uint32_t magic;
+   uint16_t version;
+   uint16_t recordSize;
+   int32_t width;
+   int32_t height;
+};
+
+/********************************************************************//**
+ * @struct TickRecord
+ *
+ * What happened on one move
+ **********************************************************************/
+struct TickRecord
+{
+   uint32_t tick;       // moves made before this one
+   int32_t head;        // cell of the head after the move
+   int32_t food;        // cell of the food after the move, -1 if none
+   int32_t length;      // body segments behind the head
+   float planMicros;    // time the player took to choose the move
+   uint8_t move;        // the ValidMove chosen
+   uint8_t alive;       // 0 if this move ended the game
+   uint16_t reserved;
+};
+
+/********************************************************************//**
+ * @class TelemetryLog
+ *
+ * A telemetry file and the thread that writes it.  publish() is for one
+ * producer thread only.  Destroying the log writes whatever is still in
+ * the ring and closes the file.
+ **********************************************************************/
+class TelemetryLog
+{
+   SpscRing<TickRecord> ring;
+   FILE *file;
+   std::atomic<bool> stopping;
+   std::atomic<long> dropped;
+   std::thread consumer;
+
+public:
+   TelemetryLog(const std::string &path, int width, int height,
+                size_t capacity = TELEMETRY_CAPACITY);
+   ~TelemetryLog();
+
+   bool good() const;
+   bool publish(const TickRecord &);
+   long droppedCount() const;
+
+private:
+   void drain();
+};
+#endif
@@ -0,0 +1,119 @@
+/********************************************************************//**
+ * @file
+ ***********************************************************************/
+#include "threadPool.h"
+
+// Start threadCount workers, or one per hardware thread if threadCount
+// is not positive
+ThreadPool::ThreadPool(int threadCount) : pending(0), queued(0),
+   nextWorker(0), stopping(false)
+{
+   if (threadCount <= 0)
+      threadCount = std::thread::hardware_concurrency();
+   if (threadCount <= 0)
+      threadCount = 1;
+
+   for (int i = 0 ; i < threadCount ; i++)
+      workers.push_back(new Worker);
+   for (int i = 0 ; i < threadCount ; i++)
+      threads.push_back(std::thread(&ThreadPool::run, this, i));
+}
+
+// Finish the queued work and join the workers
+ThreadPool::~ThreadPool()
+{
+   wait();
+   {
+      std::lock_guard<std::mutex> guard(waitLock);
+      stopping = true;
+   }
+   workReady.notify_all();
+
+   for (std::thread &t : threads)
+      t.join();
+   for (Worker *w : workers)
+      delete w;
+}
+
+// Queue a task.  Tasks are dealt to the workers round robin; idle workers
+// steal whatever is left over.
+void ThreadPool::submit(std::function<void()> task)
+{
+   Worker *w = workers[nextWorker++ % workers.size()];
+   {
+      std::lock_guard<std::mutex> guard(w->lock);
+      w->tasks.push_back(std::move(task));
+   }
+   {
+      std::lock_guard<std::mutex> guard(waitLock);
+      pending++;
+      queued++;
+   }
+   workReady.notify_one();
+}
+
+// Block until every submitted task has finished
+void ThreadPool::wait()
+{
+   std::unique_lock<std::mutex> guard(waitLock);
+   allDone.wait(guard, [this] { return pending == 0; });
+}
+
+// Number of worker threads
+int ThreadPool::size() const { return threads.size(); }
+
+// Take a task from our own deque, or steal one from another worker
+bool ThreadPool::takeTask(int self, std::function<void()> &task)
+{
+   Worker *own = workers[self];
+   {
+      std::lock_guard<std::mutex> guard(own->lock);
+      if (!own->tasks.empty())
+      {
+         task = std::move(own->tasks.back());
+         own->tasks.pop_back();
+         queued--;
+         return true;
+      }
+   }
+
+   for (size_t i = 1 ; i < workers.size() ; i++)
+   {
+      Worker *victim = workers[(self + i) % workers.size()];
+      std::lock_guard<std::mutex> guard(victim->lock);
+      if (!victim->tasks.empty())
+      {
+         task = std::move(victim->tasks.front());
+         victim->tasks.pop_front();
+         queued--;
+         return true;
+      }
+   }
+   return false;
+}
+
+// Worker loop: run tasks until the pool is destroyed
+void ThreadPool::run(int self)
+{
+   std::function<void()> task;
+
+   while (true)
+   {
+      if (takeTask(self, task))
+      {
+         task();
+         task = nullptr;
+
+         std::lock_guard<std::mutex> guard(waitLock);
+         if (--pending == 0)
+            allDone.notify_all();
+         continue;
+      }
+
+      // queued is raised under waitLock before submit notifies, so a task
+      // pushed after the steal attempt above is never missed
+      std::unique_lock<std::mutex> guard(waitLock);
+      workReady.wait(guard, [this] { return stopping || queued > 0; });
+      if (stopping && queued == 0) return;
+   }
+}
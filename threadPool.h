@@ -0,0 +1,52 @@
+/********************************************************************//**
+ * @file
+ ***********************************************************************/
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/********************************************************************//**
+ * @class ThreadPool
+ *
+ * A fixed set of worker threads with one task deque each.  A worker takes
+ * work from the back of its own deque and, when that is empty, steals from
+ * the front of another worker's deque, so long tasks on one thread do not
+ * leave the others idle.
+ **********************************************************************/
+class ThreadPool
+{
+   struct Worker
+   {
+      std::mutex lock;
+      std::deque<std::function<void()>> tasks;
+   };
+
+   std::vector<Worker *> workers;
+   std::vector<std::thread> threads;
+   std::atomic<int> pending;
+   std::atomic<int> queued;
+   std::atomic<unsigned> nextWorker;
+   std::mutex waitLock;
+   std::condition_variable workReady;
+   std::condition_variable allDone;
+   bool stopping;
+
+public:
+   ThreadPool(int threadCount);
+   ~ThreadPool();
+
+   void submit(std::function<void()>);
+   void wait();
+   int size() const;
+
+private:
+   void run(int);
+   bool takeTask(int, std::function<void()> &);
+};
+#endif
@@ -0,0 +1,57 @@
+/********************************************************************//**
+ * @file
+ ***********************************************************************/
+#ifndef TRIPLEBUFFER_H
+#define TRIPLEBUFFER_H
+#include <atomic>
+
+/********************************************************************//**
+ * @class TripleBuffer
+ *
+ * Hands the latest of a stream of values from one writer thread to one
+ * reader thread without locks and without either side waiting.  The
+ * writer fills the back slot and publishes it, swapping it with the
+ * middle slot; the reader swaps the middle slot with its front slot when
+ * something new has been published.  Values the reader was too slow to
+ * see are overwritten, so it always gets the newest one.  The slots are
+ * reused, so a T that keeps its storage, such as a vector that is
+ * assigned to, is never reallocated.
+ **********************************************************************/
+template<class T>
+class TripleBuffer
+{
+   static const int FRESH = 4;   // set in middle when it has not been read
+   static const int SLOT = 3;
+
+   T slots[3];
+   std::atomic<int> middle;
+   int back;                     // only used by the writer
+   int front;                    // only used by the reader
+
+public:
+   TripleBuffer() : middle(1), back(0), front(2) {}
+
+   // Writer: the slot to fill, then publish
+   T &writeSlot() { return slots[back]; }
+
+   void publish()
+   {
+      back = middle.exchange(back | FRESH, std::memory_order_acq_rel) & SLOT;
+   }
+
+   // Reader: take the newest published value, if there is one not yet
+   // read, and return whether there was
+   bool update()
+   {
+      if (!(middle.load(std::memory_order_relaxed) & FRESH)) return false;
+      front = middle.exchange(front, std::memory_order_acq_rel) & SLOT;
+      return true;
+   }
+
+   // Reader: the value last taken by update
+   const T &readSlot() const { return slots[front]; }
+
+   // Every slot, for setting them up before either thread starts
+   T &slot(int i) { return slots[i]; }
+};
+#endif
@@ -1,13 +1,40 @@
 #include "util.h"
+#include <cstdio>
+#include "boardRenderer.h"
+
+// How long a finished game stays on screen before the next one starts
+#define GAME_OVER_MSEC 2000
+
+// The game on screen and how the games are played
+static Simulation *sim = NULL;
+static BoardRenderer *renderer = NULL;
+static int tickMsec = 2000;
+static int ticksPerFrame = 1;
+static int gamesLeft = 1;
+static bool ending = false;
+
+// Events waiting to be handled, and the score in the window title
+static EventQueue events;
+static bool dispatching = false;
+static int shownScore = -1;
+
+// Play games games one after the other, making ticks moves every msec
+// milliseconds, or as fast as possible if msec is 0
+void setPlayback(int msec, int ticks, int games)
+{
+   tickMsec = msec > 0 ? msec : 0;
+   ticksPerFrame = ticks > 0 ? ticks : 1;
+   gamesLeft = games > 0 ? games : 1;
+}
 
 void keyboard(unsigned char key, int x, int y)
 {
-   utilityCentral(new KeyboardEvent(key, x, y));
+   utilityCentral(Event::key(key, x, y));
 }
 
 void display()
 {
-   utilityCentral(new DisplayEvent); 
+   utilityCentral(Event::display());
 }
 
 void reshape(int w, int h)
@@ -16,42 +43,93 @@ void reshape(int w, int h)
    gluOrtho2D(0.0,w,0.0,h);
    glViewport(0,0,w,h);        // adjust viewport to new window
    glutPostRedisplay();
-   utilityCentral(new ReshapeEvent(w, h));
+   utilityCentral(Event::resize(w, h));
 }
 
 void ticktock(int value)
 {
-   utilityCentral(new TickTockEvent);
+   utilityCentral(Event::tick());
    glutTimerFunc(value, ticktock, value);
 }
 
-void updateScore(Game *game)
+// Show the score in the window title when it has changed
+void updateScore(Simulation *sim)
 {
-   std::stringstream ss;
-   ss << "Score = " << game->getScore();
-   glutSetWindowTitle(ss.str().c_str());
+   int score = sim->getScore();
+   if (score == shownScore) return;
+
+   char title[32];
+   snprintf(title, sizeof title, "Score = %d", score);
+   glutSetWindowTitle(title);
+   shownScore = score;
 }
 
-void utilityCentral(Event *event)
+// Replace the game on screen with a new one
+static void newGame()
 {
-   static Player *player = new Player();
+   delete renderer;
+   delete sim;
+
    // Passing a true parameter to the Playfield constructor will include
    // obstacles on the playfield.  Passing nothing or false prevents
    // obstacles from being added
-   static Playfield *playfield = new Playfield(true);
-   static Game *game = new Game(player, playfield);
+   Playfield *playfield = new Playfield(true);
+   renderer = new BoardRenderer(playfield->getWidth(), playfield->getHeight(),
+                                glutGet(GLUT_WINDOW_WIDTH),
+                                glutGet(GLUT_WINDOW_HEIGHT));
+   sim = new Simulation(new Player(), playfield, tickMsec, ticksPerFrame);
+   sim->start();
+   shownScore = -1;
+}
+
+// Stop the game thread and free the game once the main loop has returned
+void shutdown()
+{
+   delete renderer;
+   delete sim;
+   renderer = NULL;
+   sim = NULL;
+}
 
-   if (game->isGameOver()) 
+// Called by a timer once a finished game has been on screen long enough
+static void gameOverDone(int)
+{
+   ending = false;
+   if (--gamesLeft > 0)
    {
-      std::cout << "GAME OVER!" << std::endl ; 
-      std::cout << "Final Score: " << game->getScore() << std::endl;
-      delete game;
-      glutLeaveMainLoop();
+      newGame();
+      glutPostRedisplay();
    }
    else
+      glutLeaveMainLoop();
+}
+
+// A game has just ended.  It stays on screen while the event loop carries
+// on, and a timer moves on to the next game or quits.
+static void gameOver()
+{
+   ending = true;
+   std::cout << "GAME OVER!" << std::endl ; 
+   std::cout << "Final Score: " << sim->getScore() << std::endl;
+   glutPostRedisplay();
+   glutTimerFunc(GAME_OVER_MSEC, gameOverDone, 0);
+}
+
+// Queue an event and handle everything queued.  An event raised while
+// another is being handled waits its turn rather than running inside it.
+void utilityCentral(const Event &event)
+{
+   if (!sim) newGame();
+   events.push(event);
+   if (dispatching) return;
+
+   dispatching = true;
+   Event next;
+   while (events.pop(next))
    {
-      event->doAction(game);
-      updateScore(game);
+      doAction(next, sim, renderer);
+      if (sim->isGameOver() && !ending) gameOver();
+      updateScore(sim);
    }
-   delete event;
+   dispatching = false;
 }
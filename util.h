@@ -1,9 +1,11 @@
 #ifndef UTIL_H
 #define UTIL_H
 #include <GL/freeglut.h>
-#include <sstream>
 #include "event.h"
 
+// Time between frames, about 60 a second
+#define FRAME_MSEC 16
+
 /// Keyboard handler
 void keyboard(unsigned char, int, int);
 /// Display handler
@@ -15,5 +17,9 @@ void ticktock(int);
 /// other function prototypes
 /// Function to do the initialization of the openGL event handlers
 void initOpenGL(int msec);
-void utilityCentral(Event*);
+/// Set the time between moves, the moves per tick and the number of games
+void setPlayback(int msec, int ticks, int games);
+/// Stop the game once the main loop has returned
+void shutdown();
+void utilityCentral(const Event &);
 #endif
@@ -0,0 +1,27 @@
+/********************************************************************//**
+ * @file
+ ***********************************************************************/
+#ifndef VERTEXRANGE_H
+#define VERTEXRANGE_H
+
+/********************************************************************//**
+ * @class VertexRange
+ *
+ * A read-only run of vertex numbers inside a graph.  It points into the
+ * graph, so iterating it never allocates, and it is valid for as long as
+ * the graph is and is not rebuilt.
+ **********************************************************************/
+class VertexRange
+{
+   const int *first;
+   const int *last;
+
+public:
+   VertexRange(const int *f, const int *l) : first(f), last(l) {}
+
+   const int *begin() const { return first; }
+   const int *end() const { return last; }
+   int size() const { return last - first; }
+   bool empty() const { return first == last; }
+};
+#endif
@@ -11,9 +11,22 @@
  *
  * Modifications:
  *    * Added doxygen style comments: SPR 05/01/2020
+ *    * Replaced the map/multiset adjacency with compressed sparse rows
  ******************************************************************************/
 
 #include "weightedGraph.h"
+#include "gridDims.h"
+
+//Passes the dimension type picked by withGridDims on to build
+struct WeightedGraph::Builder
+{
+	WeightedGraph *G;
+	const GridCell *grid;
+	template <class Dims> void operator()(const Dims &dims)
+	{
+		G->build(dims, grid);
+	}
+};
 
 /*************************************************************************//**
  * @brief Default Constructor for class Weightedgraph
@@ -22,14 +35,17 @@
  *
  * @returns WeightedGraph - an instance of class WeightedGraph
  ****************************************************************************/
-WeightedGraph::WeightedGraph() : numVertices(0), numEdges(0){}
+WeightedGraph::WeightedGraph() : width(0), height(0), numVertices(0),
+	numEdges(0), offsets(1, 0), weight(nullptr), cellCost(nullptr) {}
 
 /*************************************************************************//**
- * @brief Constructor for class WeightedGraph that converts an integer array 
+ * @brief Constructor for class WeightedGraph that converts a grid of cells
  * 	  to a weighted graph.
  *
  * @par Description
- *	Converts a 1d integer array to a weighted graph
+ *	Converts a 1d array of cells to a weighted graph in a single row-major
+ *	pass. Every open cell gets an arc to each open 4-neighbour; the arcs are
+ *	appended to one contiguous array so no per-edge nodes are allocated.
  *
  * @param[in] grid - the playfield
  * @param[in] width - the width of the playfield
@@ -37,133 +53,142 @@ WeightedGraph::WeightedGraph() : numVertices(0), numEdges(0){}
  *
  * @returns WeightedGraph - an instance of class WeightedGraph
  ****************************************************************************/
-WeightedGraph::WeightedGraph(const int *grid, int width, int height)
+WeightedGraph::WeightedGraph(const GridCell *grid, int width, int height)
+	: width(width), height(height), numVertices(0), numEdges(0),
+	weight(&CellWeights::forSize(width, height)), cellCost(weight->data())
 {
-	numEdges = 0;
+	int cells = width * height;
+
+	offsets.resize(cells + 1);
+	targets.reserve(4 * cells);
+	weights.reserve(4 * cells);
+	vertexList.reserve(cells);
+
+	//Use constant dimensions for the common board sizes
+	Builder builder = {this, grid};
+	withGridDims(width, height, builder);
+
+	numVertices = vertexList.size();
+	//Every arc has a reverse arc, so each undirected edge is stored twice
+	numEdges = targets.size() / 2;
+}
 
-	for(int i = 0; i < (width * height); i++)
+/*************************************************************************//**
+ * @brief fills the arrays of the graph from a grid
+ *
+ * @par Description
+ *	Walks the grid row by row. When Dims is a FixedGridDims the bounds and
+ *	index arithmetic are compile time constants.
+ *
+ * @param[in] dims - the dimensions of the grid
+ * @param[in] grid - the playfield
+ *
+ * @returns none
+ ****************************************************************************/
+template <class Dims>
+void WeightedGraph::build(const Dims &dims, const GridCell *grid)
+{
+	const int *cost = weight->data();
+	const int w = dims.width();
+	const int h = dims.height();
+
+	for(int row = 0; row < h; row++)
 	{
-		int row = i / width;
-		int col = i % width;
-		//
-		if(grid[i] != 1)
+		for(int col = 0; col < w; col++)
 		{
-			
-			row -= 1;
+			int i = dims.index(row, col);
+			offsets[i] = targets.size();
+
+			if(grid[i] == TAIL_VALUE)
+				continue;
+
+			vertexList.push_back(i);
+
 			//Check up
-			if(row >= 0 && col >= 0)
+			if(row > 0 && grid[i - w] != TAIL_VALUE)
 			{
-				int up = row * width + col;
-				if(grid[up]!=1)
-					addEdge(Edge(i, up, weight[row][col]));
+				targets.push_back(i - w);
+				weights.push_back(cost[i - w]);
 			}
 
-			row += 2;
 			//Check down
-			if(row < height && col < width)
+			if(row < h - 1 && grid[i + w] != TAIL_VALUE)
 			{
-				int down = row * width + col;
-				if(grid[down]!=1)
-					addEdge(Edge(i, down, weight[row][col]));
+				targets.push_back(i + w);
+				weights.push_back(cost[i + w]);
 			}
 
-			row -= 1;
-			col -= 1;
 			//Check left
-			if(row >= 0 && col >= 0)
+			if(col > 0 && grid[i - 1] != TAIL_VALUE)
 			{
-				int left = row * width + col;
-				if(grid[left]!=1)
-					addEdge(Edge(i, left, weight[row][col]));
+				targets.push_back(i - 1);
+				weights.push_back(cost[i - 1]);
 			}
 
-			col += 2;
 			//Check right
-			if(row < height && col < width)
+			if(col < w - 1 && grid[i + 1] != TAIL_VALUE)
 			{
-				int right = row * width + col;
-				if(grid[right]!=1)
-					addEdge(Edge(i, right, weight[row][col]));
+				targets.push_back(i + 1);
+				weights.push_back(cost[i + 1]);
 			}
 		}
 	}
-}
-
-/*************************************************************************//**
- * @brief adds an edge to the weighted graph 
- *
- * @par Description
- *   The function gets the vertices of the edge and inserts into a map to 
- *   store them
- *
- * @param[in] e - an edge
- *
- * @returns none
- ****************************************************************************/
-
-void WeightedGraph::addEdge(Edge e)
-{
-  int v = e.either();
-  int w = e.other(v);
-	//Store the edge
-  edges[v].insert(e);
-  edges[w].insert(e);
-	//Store the vertices
-  vertices.insert(v);
-  vertices.insert(w);
-
-  return;
+	offsets[dims.cells()] = targets.size();
 }
 
 /*************************************************************************//**
  * @brief get all the edges of the graph
  *
  * @par Description
- *   The function retrives all the edges of the graph
+ *   The function returns a view of every directed arc of the graph. Both
+ *   directions of an undirected edge are included since their weights may
+ *   differ. The view points into the graph and allocates nothing.
  *
  * @param[in] none
  *
- * @returns returnVal - a multiset of edges
+ * @returns a range of edges
  ****************************************************************************/
-multiset<Edge> WeightedGraph::Edges()
+EdgeList WeightedGraph::Edges() const
 {
-  multiset<Edge> returnVal;
-
-  for (auto &kv : edges)
-    for (Edge e : edges[kv.first])
-      returnVal.insert(e);
-
-  return returnVal;
+  return EdgeList(offsets.data(), targets.data(), weights.data(),
+                  targets.size());
 }
 
 /*************************************************************************//**
  * @brief gets the vertices of the graph
  *
  * @par Description
- *   The function retrieves a set of vertices of the graph
+ *   The function returns a view of the vertices of the graph, in
+ *   increasing order
  *
  * @param[in] none
  *
- * @returns vertices - a set of vertices
+ * @returns a range of vertices
  ****************************************************************************/
-set<int> WeightedGraph::Vertices() const
+VertexRange WeightedGraph::Vertices() const
 {
-  return vertices;
+  return VertexRange(vertexList.data(), vertexList.data() + numVertices);
 }
 
 /*************************************************************************//**
  * @brief get the adjacent edges of a vertex
  *
  * @par Description
- *   The function retrieves a set of adjacent edges to a vertex
+ *   The function returns a view of the edges leaving a vertex. The view
+ *   points into the graph and is valid for as long as the graph is.
  *
  * @param[in] v - the vertex
  *
- * @returns edges - a multiset of edges
+ * @returns a range of edges
  ****************************************************************************/
-multiset<Edge> WeightedGraph::adj(int v)
+EdgeRange WeightedGraph::adj(int v) const
 {
-  return edges[v];
+  if (v < 0 || v >= width * height)
+    return EdgeRange(v, nullptr, nullptr, 0);
+
+  int first = offsets[v];
+  return EdgeRange(v, targets.data() + first, weights.data() + first,
+                   offsets[v + 1] - first);
 }
 
 /*************************************************************************//**
@@ -195,3 +220,44 @@ int WeightedGraph::E() const
 {
   return numEdges;
 }
+
+/*************************************************************************//**
+ * @brief get the width of the grid the graph was built from
+ *
+ * @param[in] none
+ *
+ * @returns width - number of columns
+ ****************************************************************************/
+int WeightedGraph::Width() const
+{
+  return width;
+}
+
+/*************************************************************************//**
+ * @brief get the height of the grid the graph was built from
+ *
+ * @param[in] none
+ *
+ * @returns height - number of rows
+ ****************************************************************************/
+int WeightedGraph::Height() const
+{
+  return height;
+}
+
+/*************************************************************************//**
+ * @brief get the smallest weight any edge of the graph can have
+ *
+ * @par Description
+ *   The function returns the smallest entry of the graph's weight table.
+ *   Every arc costs at least this much, which makes it a safe scale for
+ *   distance estimates.
+ *
+ * @param[in] none
+ *
+ * @returns the smallest cell weight
+ ****************************************************************************/
+int WeightedGraph::MinWeight() const
+{
+  return weight ? weight->min() : 1;
+}
@@ -11,56 +11,132 @@
  *
  * Modifications:
  *    * Added doxygen style comments: SPR 05/01/2020
+ *    * Replaced the map/multiset adjacency with compressed sparse rows
  ******************************************************************************/
 
 #ifndef WEIGHTEDGRAPH_H
 #define WEIGHTEDGRAPH_H
 #include <iostream>
-#include <map>
-#include <set>
+#include <vector>
 #include "edge.h"
+#include "vertexRange.h"
+#include "gridGraph.h"
 #include "playfield.h"
+#include "cellWeights.h"
 
 using namespace std;
 
-//typedefing map<int, multiset<int>> as map_t
-typedef map<int, multiset<Edge>> map_t;
+/*!
+* @brief a read-only view of the edges leaving one vertex. The edges are
+*        produced on the fly from the graph's contiguous arrays, so iterating
+*        a view never allocates.
+*/
+class EdgeRange
+{
+   int v;
+   const int *to;
+   const int *wt;
+   int n;
+public:
+   class iterator
+   {
+      int v;
+      const int *to;
+      const int *wt;
+   public:
+      iterator(int s, const int *t, const int *w) : v(s), to(t), wt(w) {}
+      Edge operator*() const { return Edge(v, *to, *wt); }
+      iterator &operator++() { ++to; ++wt; return *this; }
+      bool operator!=(const iterator &rhs) const { return to != rhs.to; }
+   };
+
+   EdgeRange(int s, const int *t, const int *w, int count)
+      : v(s), to(t), wt(w), n(count) {}
+
+   iterator begin() const { return iterator(v, to, wt); }
+   iterator end() const { return iterator(v, to + n, wt + n); }
+   int size() const { return n; }
+};
+
+/*!
+* @brief a read-only view of every arc of a graph, in order of source
+*        vertex. Like EdgeRange it reads the graph's arrays in place.
+*/
+class EdgeList
+{
+   const int *offsets;
+   const int *to;
+   const int *wt;
+   int n;
+public:
+   class iterator
+   {
+      const int *offsets;
+      const int *to;
+      const int *wt;
+      int v;
+      int i;
+      int n;
+      //Move v on to the source of arc i, past vertices with no arcs
+      void settle() { while (i < n && offsets[v + 1] <= i) v++; }
+   public:
+      iterator(const int *o, const int *t, const int *w, int arc, int count)
+         : offsets(o), to(t), wt(w), v(0), i(arc), n(count) { settle(); }
+      Edge operator*() const { return Edge(v, to[i], wt[i]); }
+      iterator &operator++() { ++i; settle(); return *this; }
+      bool operator!=(const iterator &rhs) const { return i != rhs.i; }
+   };
+
+   EdgeList(const int *o, const int *t, const int *w, int count)
+      : offsets(o), to(t), wt(w), n(count) {}
+
+   iterator begin() const { return iterator(offsets, to, wt, 0, n); }
+   iterator end() const { return iterator(offsets, to, wt, n, n); }
+   int size() const { return n; }
+};
 
 /********************************************************************//**
  * @class WeightedGraph
+ *
+ * A directed 4-neighbour grid graph stored in compressed sparse row form.
+ * The arcs leaving cell v are targets[offsets[v]] .. targets[offsets[v+1]-1]
+ * and the cost of an arc is the CellWeights entry of its destination cell.
+ * It models the grid graph concept of gridGraph.h.
  **********************************************************************/
 class WeightedGraph
 {
-   int numVertices,numEdges;
-   map_t edges;
-   set<int> vertices;
-   int  weight[PLAYFIELD_WIDTH][PLAYFIELD_HEIGHT] = 
-   { 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,64, 64, 64, 64, 64, 64, 64,
-64, 49, 49, 49, 49, 49, 49, 49, 49, 49, 49, 49, 49, 49 ,49, 49, 64,
-64, 49, 49, 36, 36, 36, 36, 36, 36, 36, 36 ,36, 36, 36, 49, 49, 64,
-64, 49, 49, 36, 25, 25, 25, 25, 25, 25, 25, 25, 25, 36, 49, 49, 64,
-64, 49, 49, 36, 25, 16, 16, 16 ,16, 16, 16, 16, 25, 36, 49, 49, 64,
-64, 49, 49, 36, 25, 16, 4, 4, 4, 4, 4, 16, 25, 36 ,49, 49, 64,
-64, 49, 49, 36, 25, 16, 4, 2, 2, 2, 4 ,16, 25, 36, 49, 49, 64,
-64, 49, 49, 36, 25, 16, 4, 2, 1, 2, 4, 16, 25, 36, 49, 49, 64,
-64, 49, 49, 36, 25, 16, 4, 2 ,2, 2, 4, 16, 25, 36, 49, 49, 64,
-64, 49, 49, 36, 25, 16, 4, 4, 4, 4, 4, 16, 25, 36, 49, 49, 64,
-64, 49, 49, 36, 25, 16, 16, 16, 16, 16, 16, 16, 25, 36, 49, 49, 64,
-64, 49, 49, 36, 25, 25, 25, 25, 25, 25, 25, 25, 25, 36, 49, 49, 64,
-64, 49, 49, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 49, 49, 64,
-64, 49, 49, 49, 49, 49, 49, 49, 49, 49, 49, 49, 49, 49 ,49, 49, 64,
-64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64
-};
+   int width, height;
+   int numVertices, numEdges;
+   vector<int> offsets;
+   vector<int> targets;
+   vector<int> weights;
+   vector<int> vertexList;
+   const CellWeights *weight;
+   const int *cellCost;
+
+   struct Builder;
+   template <class Dims> void build(const Dims &, const GridCell *);
 
 public:
    WeightedGraph();
-   WeightedGraph(const int *, int, int);
+   WeightedGraph(const GridCell *, int, int);
 
-   void addEdge(Edge);
-   multiset<Edge> adj(int);
-   multiset<Edge> Edges();
-   set<int> Vertices() const;
+   EdgeRange adj(int) const;
+   EdgeList Edges() const;
+   VertexRange Vertices() const;
    int V() const;
    int E() const;
+   int Width() const;
+   int Height() const;
+   int MinWeight() const;
+
+   // The grid graph concept
+   int cells() const { return width * height; }
+   int cost(int w) const { return cellCost ? cellCost[w] : 1; }
+   int neighbour(int v, int k) const
+   {
+      int i = offsets[v] + k;
+      return i < offsets[v + 1] ? targets[i] : NO_NEIGHBOUR;
+   }
 };
 #endif